@@ -0,0 +1,296 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 Alexandre Bailon
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Compress, diff and upload firmware images with the ESPHome OTA protocol.
+
+"upload" sends an image (zephyr.signed.bin) to a device. When the device
+supports compressed images (CONFIG_ESPHOME_OTA_DEFLATE), the image is
+compressed with the window the device asked for, and inflated by the
+device while it is written to the flash. With --old, the image running on
+the device, a patch is sent instead of the image when the device supports
+delta updates (CONFIG_ESPHOME_OTA_DELTA), and the device rebuilds the new
+image from its primary slot.
+
+"compress" and "delta" write the compressed image and the patch to a
+file, to check their size.
+
+A compressed image is the size of the image, 4 bytes big endian as the
+size of the upload, followed by the image compressed as a raw deflate
+stream (RFC 1951).
+
+A patch is a header, the magic "DLT1", the size and the MD5 of the old
+image, and the size of the new image, followed by records made of the
+diff and extra lengths and the seek in the old image, each followed by the
+diff bytes, added to the old image ones, and the extra bytes, copied. All
+the fields are 4 bytes little endian. The patch is compressed as an image
+when the device supports it.
+
+The MD5 sent to the device is the one of the new, uncompressed, image.
+"""
+
+import argparse
+import hashlib
+import socket
+import struct
+import sys
+import zlib
+
+MAGIC_BYTES = bytes([0x6C, 0x26, 0xF7, 0x5C, 0x45])
+OTA_PORT = 8266
+OTA_BLOCK_SIZE = 8192
+OTA_VERSION = 2
+
+FEATURE_SUPPORTS_DELTA = 0x40
+FEATURE_SUPPORTS_DEFLATE = 0x80
+
+RESPONSE_OK = 0x00
+RESPONSE_HEADER_OK = 0x40
+RESPONSE_AUTH_OK = 0x41
+RESPONSE_UPDATE_PREPARE_OK = 0x42
+RESPONSE_BIN_MD5_OK = 0x43
+RESPONSE_RECEIVE_OK = 0x44
+RESPONSE_UPDATE_END_OK = 0x45
+RESPONSE_CHUNK_OK = 0x47
+RESPONSE_SUPPORTS_DEFLATE = 0x50
+RESPONSE_SUPPORTS_DELTA = 0x51
+
+RESPONSE_ERRORS = {
+    0x80: "invalid magic",
+    0x81: "update prepare failed",
+    0x82: "invalid password",
+    0x83: "flash write failed",
+    0x84: "update end failed",
+    0x8B: "MD5 mismatch",
+    0xFF: "unknown error",
+}
+
+DEFAULT_WINDOW_BITS = 12
+
+DELTA_MAGIC = b"DLT1"
+DELTA_HEADER = struct.Struct("<4sI16sI")
+DELTA_RECORD = struct.Struct("<IIi")
+# Length of the substrings of the old image looked up to find the matches
+DELTA_MATCH_LEN = 8
+# A match is extended until it doesn't improve for this many bytes
+DELTA_MATCH_SLACK = 64
+
+
+def compress(image, window_bits):
+    # Raw deflate, without the zlib header, so the window is the one asked
+    compressor = zlib.compressobj(9, zlib.DEFLATED, -window_bits, 9)
+    return struct.pack(">I", len(image)) + compressor.compress(image) + compressor.flush()
+
+
+def extend_match(old, new, old_pos, new_pos):
+    # Longest length where more bytes match than not, as bsdiff does, so that
+    # the code which only moved gives diff bytes which are mostly zeros
+    best_score = score = best_len = 0
+    for length in range(1, min(len(old) - old_pos, len(new) - new_pos) + 1):
+        score += 1 if old[old_pos + length - 1] == new[new_pos + length - 1] else -1
+        if score > best_score:
+            best_score, best_len = score, length
+        elif length - best_len > DELTA_MATCH_SLACK:
+            break
+    return best_len
+
+
+def find_matches(old, new):
+    index = {}
+    for pos in range(len(old) - DELTA_MATCH_LEN + 1):
+        index.setdefault(old[pos:pos + DELTA_MATCH_LEN], pos)
+
+    # (new position, old position, length), in the order of the new image
+    matches = []
+    new_pos = 0
+    while new_pos <= len(new) - DELTA_MATCH_LEN:
+        # The previous match often continues after a few changed bytes
+        old_pos = None
+        if matches:
+            match_new, match_old, _ = matches[-1]
+            aligned = match_old + new_pos - match_new
+            if new[new_pos:new_pos + DELTA_MATCH_LEN] == old[aligned:aligned + DELTA_MATCH_LEN]:
+                old_pos = aligned
+        if old_pos is None:
+            old_pos = index.get(new[new_pos:new_pos + DELTA_MATCH_LEN])
+        if old_pos is None:
+            new_pos += 1
+            continue
+
+        length = extend_match(old, new, old_pos, new_pos)
+        matches.append((new_pos, old_pos, length))
+        new_pos += length
+    return matches
+
+
+def make_delta(old, new):
+    matches = find_matches(old, new)
+
+    patch = bytearray(DELTA_HEADER.pack(DELTA_MAGIC, len(old), hashlib.md5(old).digest(),
+                                        len(new)))
+    # The new image bytes before the first match are copied
+    first_new, first_old = (matches[0][0], matches[0][1]) if matches else (len(new), 0)
+    patch += DELTA_RECORD.pack(0, first_new, first_old)
+    patch += new[:first_new]
+
+    for i, (new_pos, old_pos, length) in enumerate(matches):
+        next_new, next_old = (matches[i + 1][:2] if i + 1 < len(matches)
+                              else (len(new), old_pos + length))
+        patch += DELTA_RECORD.pack(length, next_new - new_pos - length,
+                                   next_old - old_pos - length)
+        patch += bytes((n - o) & 0xFF for n, o in zip(new[new_pos:new_pos + length],
+                                                      old[old_pos:old_pos + length]))
+        patch += new[new_pos + length:next_new]
+    return bytes(patch)
+
+
+def apply_delta(old, patch):
+    # Same as the device, to check the patch before sending it
+    magic, old_size, old_md5, new_size = DELTA_HEADER.unpack_from(patch)
+    if magic != DELTA_MAGIC or old_size != len(old) or old_md5 != hashlib.md5(old).digest():
+        raise ValueError("the patch doesn't apply to this image")
+
+    new = bytearray()
+    pos = DELTA_HEADER.size
+    old_pos = 0
+    while pos < len(patch):
+        diff_len, extra_len, seek = DELTA_RECORD.unpack_from(patch, pos)
+        pos += DELTA_RECORD.size
+        new += bytes((d + o) & 0xFF for d, o in zip(patch[pos:pos + diff_len],
+                                                    old[old_pos:old_pos + diff_len]))
+        pos += diff_len
+        new += patch[pos:pos + extra_len]
+        pos += extra_len
+        old_pos += diff_len + seek
+    if len(new) != new_size:
+        raise ValueError("truncated patch")
+    return bytes(new)
+
+
+def receive(sock, expected):
+    data = sock.recv(1)
+    if not data:
+        sys.exit("connection closed by the device")
+
+    response = data[0]
+    if response not in expected:
+        sys.exit("device error 0x%02x: %s" % (response,
+                                                RESPONSE_ERRORS.get(response, "unexpected")))
+    return response
+
+
+def upload(image, host, port, compressed, old):
+    features = FEATURE_SUPPORTS_DEFLATE if compressed else 0
+    if old is not None:
+        features |= FEATURE_SUPPORTS_DELTA
+
+    with socket.create_connection((host, port), timeout=20) as sock:
+        sock.sendall(MAGIC_BYTES)
+        receive(sock, (RESPONSE_OK,))
+        version = sock.recv(1)
+        if not version or version[0] != OTA_VERSION:
+            sys.exit("unsupported OTA version")
+
+        sock.sendall(bytes([features]))
+        response = receive(sock, (RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_DEFLATE,
+                                  RESPONSE_SUPPORTS_DELTA))
+        data = image
+        if response == RESPONSE_SUPPORTS_DELTA:
+            data = make_delta(old, image)
+            print("Patch of %d bytes for an image of %d" % (len(data), len(image)))
+        elif old is not None:
+            print("The device doesn't support delta updates, sending the image")
+
+        window_bits = sock.recv(1)[0] if response != RESPONSE_HEADER_OK else 0
+        if window_bits:
+            size = len(data)
+            data = compress(data, window_bits)
+            print("Compressed %d bytes to %d with a %d bytes window" %
+                  (size, len(data), 1 << window_bits))
+
+        receive(sock, (RESPONSE_AUTH_OK,))
+
+        sock.sendall(struct.pack(">I", len(data)))
+        receive(sock, (RESPONSE_UPDATE_PREPARE_OK,))
+
+        sock.sendall(hashlib.md5(image).hexdigest().encode())
+        receive(sock, (RESPONSE_BIN_MD5_OK,))
+
+        for offset in range(0, len(data), OTA_BLOCK_SIZE):
+            sock.sendall(data[offset:offset + OTA_BLOCK_SIZE])
+            receive(sock, (RESPONSE_CHUNK_OK,))
+            sent = min(offset + OTA_BLOCK_SIZE, len(data))
+            print("\rUploading %3d%%" % (sent * 100 // len(data)), end="", flush=True)
+        print()
+
+        # The flash writes and the MD5 check end before these
+        sock.settimeout(60)
+        receive(sock, (RESPONSE_RECEIVE_OK,))
+        receive(sock, (RESPONSE_UPDATE_END_OK,))
+        sock.sendall(bytes([RESPONSE_OK]))
+
+    print("Done, the device reboots")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    upload_parser = subparsers.add_parser("upload", help="upload an image to a device")
+    upload_parser.add_argument("image", help="image to upload")
+    upload_parser.add_argument("host", help="address of the device")
+    upload_parser.add_argument("--port", type=int, default=OTA_PORT, help="OTA port")
+    upload_parser.add_argument("--no-compress", action="store_true",
+                               help="always send the uncompressed image")
+
+    upload_parser.add_argument("--old", help="image running on the device, to send a patch")
+
+    delta_parser = subparsers.add_parser("delta", help="write the patch of an image to a file")
+    delta_parser.add_argument("old", help="image running on the device")
+    delta_parser.add_argument("image", help="new image")
+    delta_parser.add_argument("output", help="patch")
+
+    compress_parser = subparsers.add_parser("compress", help="compress an image to a file")
+    compress_parser.add_argument("image", help="image to compress")
+    compress_parser.add_argument("output", help="compressed image")
+    compress_parser.add_argument("--window-bits", type=int, default=DEFAULT_WINDOW_BITS,
+                                 choices=range(9, 16), metavar="{9..15}",
+                                 help="CONFIG_ESPHOME_OTA_DEFLATE_WINDOW_BITS of the device")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+
+    old = None
+    if getattr(args, "old", None):
+        with open(args.old, "rb") as f:
+            old = f.read()
+
+    if args.command == "compress":
+        data = compress(image, args.window_bits)
+        with open(args.output, "wb") as f:
+            f.write(data)
+        print("Compressed %d bytes to %d (%d%%)" % (len(image), len(data),
+                                                   len(data) * 100 // len(image)))
+    elif args.command == "delta":
+        data = make_delta(old, image)
+        if apply_delta(old, data) != image:
+            sys.exit("invalid patch")
+        with open(args.output, "wb") as f:
+            f.write(data)
+        print("Patch of %d bytes for an image of %d, %d compressed" %
+              (len(data), len(image), len(compress(data, DEFAULT_WINDOW_BITS))))
+    else:
+        upload(image, args.host, args.port, not args.no_compress, old)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 Alexandre Bailon
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Decode an ESPHome API trace (CONFIG_ESPHOME_RPC_TRACE).
+
+The trace is either the file written on native_sim with
+--esphome-trace=<path>, or a console log holding the output of the
+"esphome trace dump" shell command: the lines starting with "esphome-trace"
+are extracted from it, the others are ignored.
+
+Each frame is printed with its timestamp, connection, direction and
+message, whose fields are decoded without the .proto file: known fields are
+named, the others are printed by field number.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+TRACE_MAGIC = 0x54505345
+TRACE_VERSION = 1
+FILE_HEADER = struct.Struct("<IHH")
+RECORD = struct.Struct("<QIHBB")
+DUMP_PREFIX = "esphome-trace "
+
+TRACE_TYPES = {0: "RX", 1: "TX", 2: "open", 3: "close"}
+
+LIST_ENTITY_FIELDS = {1: "object_id", 2: "key", 3: "name", 4: "unique_id"}
+
+# Message id: (name, {field number: field name})
+MESSAGES = {
+    1: ("HelloRequest", {1: "client_info", 2: "api_version_major", 3: "api_version_minor"}),
+    2: ("HelloResponse", {1: "api_version_major", 2: "api_version_minor", 3: "server_info",
+                          4: "name"}),
+    3: ("ConnectRequest", {1: "password"}),
+    4: ("ConnectResponse", {1: "invalid_password"}),
+    5: ("DisconnectRequest", {}),
+    6: ("DisconnectResponse", {}),
+    7: ("PingRequest", {}),
+    8: ("PingResponse", {}),
+    9: ("DeviceInfoRequest", {}),
+    10: ("DeviceInfoResponse", {1: "uses_password", 2: "name", 3: "mac_address",
+                                4: "esphome_version", 5: "compilation_time", 6: "model"}),
+    11: ("ListEntitiesRequest", {}),
+    16: ("ListEntitiesSensorResponse", LIST_ENTITY_FIELDS),
+    17: ("ListEntitiesSwitchResponse", LIST_ENTITY_FIELDS),
+    19: ("ListEntitiesDoneResponse", {}),
+    20: ("SubscribeStatesRequest", {}),
+    25: ("SensorStateResponse", {1: "key", 2: "state", 3: "missing_state"}),
+    26: ("SwitchStateResponse", {1: "key", 2: "state"}),
+    28: ("SubscribeLogsRequest", {1: "level", 2: "dump_config"}),
+    29: ("SubscribeLogsResponse", {1: "level", 3: "message", 4: "send_failed"}),
+    33: ("SwitchCommandRequest", {1: "key", 2: "state"}),
+    34: ("SubscribeHomeassistantServicesRequest", {}),
+    38: ("SubscribeHomeAssistantStatesRequest", {}),
+    61: ("ListEntitiesButtonResponse", LIST_ENTITY_FIELDS),
+    62: ("ButtonCommandRequest", {1: "key"}),
+}
+
+
+class Truncated(Exception):
+    pass
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise Truncated()
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def format_bytes(value):
+    try:
+        text = value.decode()
+        if text.isprintable():
+            return '"%s"' % text
+    except UnicodeDecodeError:
+        pass
+    return value.hex()
+
+
+def decode_fields(body, names):
+    """Decode the fields of a protobuf message, as much of them as body holds"""
+    fields = []
+    pos = 0
+    try:
+        while pos < len(body):
+            tag, pos = read_varint(body, pos)
+            number, wire_type = tag >> 3, tag & 7
+            name = names.get(number, "#%d" % number)
+            if wire_type == 0:
+                value, pos = read_varint(body, pos)
+                value = str(value)
+            elif wire_type == 1:
+                if pos + 8 > len(body):
+                    raise Truncated()
+                raw = body[pos:pos + 8]
+                pos += 8
+                value = "0x%016x (%g)" % (struct.unpack("<Q", raw)[0],
+                                          struct.unpack("<d", raw)[0])
+            elif wire_type == 2:
+                length, pos = read_varint(body, pos)
+                if pos + length > len(body):
+                    raise Truncated()
+                value = format_bytes(body[pos:pos + length])
+                pos += length
+            elif wire_type == 5:
+                if pos + 4 > len(body):
+                    raise Truncated()
+                raw = body[pos:pos + 4]
+                pos += 4
+                if name == "key":
+                    value = "0x%08x" % struct.unpack("<I", raw)[0]
+                else:
+                    value = "%g" % struct.unpack("<f", raw)[0]
+            else:
+                fields.append("<invalid wire type %d>" % wire_type)
+                break
+            fields.append("%s: %s" % (name, value))
+    except Truncated:
+        fields.append("...")
+    return fields
+
+
+def decode_frames(data, length):
+    """Yield a description of each frame of data, the first bytes of length bytes"""
+    pos = 0
+    while pos < len(data):
+        if data[pos] != 0:
+            yield "<invalid preamble 0x%02x>" % data[pos]
+            return
+        try:
+            body_len, body_pos = read_varint(data, pos + 1)
+            msg_id, body_pos = read_varint(data, body_pos)
+        except Truncated:
+            yield "<truncated header>"
+            return
+
+        name, names = MESSAGES.get(msg_id, ("Message%d" % msg_id, {}))
+        body = data[body_pos:body_pos + body_len]
+        text = "%s (%d bytes) {%s}" % (name, body_len, ", ".join(decode_fields(body, names)))
+        if len(body) < body_len:
+            text += " [truncated]"
+        yield text
+        pos = body_pos + body_len
+
+    # Unless the last frame was already shown as truncated
+    if pos <= len(data) < length:
+        yield "[%d more bytes not traced]" % (length - len(data))
+
+
+def read_trace(path):
+    if path == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(path, "rb") as f:
+            data = f.read()
+
+    if len(data) >= 4 and struct.unpack_from("<I", data)[0] == TRACE_MAGIC:
+        return data
+
+    # Console log: each dumped line holds the hex of a header or a record
+    hex_lines = re.findall(DUMP_PREFIX.encode() + rb"([0-9a-fA-F]+)", data)
+    return b"".join(bytes.fromhex(line.decode()) for line in hex_lines)
+
+
+def parse_records(data):
+    if len(data) < FILE_HEADER.size:
+        sys.exit("Not an ESPHome API trace")
+
+    magic, version, _ = FILE_HEADER.unpack_from(data)
+    if magic != TRACE_MAGIC or version != TRACE_VERSION:
+        sys.exit("Not an ESPHome API trace, or unsupported version")
+
+    pos = FILE_HEADER.size
+    while pos + RECORD.size <= len(data):
+        timestamp, length, caplen, conn, trace_type = RECORD.unpack_from(data, pos)
+        pos += RECORD.size
+        if pos + caplen > len(data):
+            break
+        yield timestamp, conn, TRACE_TYPES.get(trace_type, "?"), length, data[pos:pos + caplen]
+        pos += caplen
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("trace", help="trace file or console log, - for stdin")
+    parser.add_argument("--conn", type=int, help="only show this connection")
+    parser.add_argument("--hex", action="store_true", help="also show the raw frames")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    for timestamp, conn, trace_type, length, data in parse_records(read_trace(args.trace)):
+        if args.conn is not None and conn != args.conn:
+            continue
+
+        prefix = "%12.6f #%d %-5s" % (timestamp / 1e6, conn, trace_type)
+        if trace_type in ("open", "close"):
+            print(prefix.rstrip())
+            continue
+
+        for frame in decode_frames(data, length):
+            print("%s %s" % (prefix, frame))
+        if args.hex:
+            print(" " * len(prefix), data.hex())
+
+
+if __name__ == "__main__":
+    main()
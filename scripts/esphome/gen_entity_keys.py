@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 Alexandre Bailon
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Generate the ESPHome entity keys from the devicetree.
+
+ESPHome identifies entities with the FNV-1 hash of their object id. This
+computes the keys of every enabled ESPHome entity at build time, so they
+don't have to be hashed at boot, and fails if two entities share a key.
+
+For each entity, the generated header defines:
+  ESPHOME_ENTITY_KEY_<object id>: the key
+  ESPHOME_ENTITY_KEY_NAME_<object id>: a token sorting like the key, used to
+  keep the entity iterable section sorted by key
+
+It also defines, to size the ListEntities cache:
+  ESPHOME_ENTITY_COUNT: the number of entities
+  ESPHOME_ENTITY_STRINGS_SIZE: the size of the strings of their ListEntities
+  responses coming from the devicetree (name, object id and unique id)
+"""
+
+import argparse
+import os
+import pickle
+import re
+import sys
+
+
+def fnv1_hash(name):
+    # Same as the hash used by ESPHome, including the NUL terminator
+    h = 2166136261
+    for c in name.encode() + b"\0":
+        h = (h * 16777619) & 0xFFFFFFFF
+        h ^= c
+    return h
+
+
+def object_id(device_name):
+    # Same as DT_STRING_TOKEN()
+    return re.sub(r"[^a-zA-Z0-9_]", "_", device_name)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--edt-pickle", required=True, help="path to edt.pickle")
+    parser.add_argument("--zephyr-base", required=True, help="path to the Zephyr tree")
+    parser.add_argument("--output", required=True, help="header to generate")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    # Required to unpickle the EDT
+    sys.path.insert(0, os.path.join(args.zephyr_base, "scripts", "dts",
+                                    "python-devicetree", "src"))
+    with open(args.edt_pickle, "rb") as f:
+        edt = pickle.load(f)
+
+    # Prefix of the unique ids, DT_ESPHOME_NAME
+    esphome = next((node for node in edt.nodes if node.path == "/esphome"), None)
+    entity_id = esphome.props["entity_id"].val if esphome and "entity_id" in esphome.props else ""
+
+    keys = {}
+    strings_size = 0
+    for node in edt.nodes:
+        if node.status != "okay" or "device_name" not in node.props:
+            continue
+        if not any(compat.startswith("nabucasa,esphome-") for compat in node.compats):
+            continue
+
+        oid = object_id(node.props["device_name"].val)
+        key = fnv1_hash(oid)
+        if key in keys:
+            other = keys[key]
+            sys.exit(f"error: ESPHome entities {other[1].path} ({other[0]}) and "
+                     f"{node.path} ({oid}) have the same key 0x{key:08x}")
+        keys[key] = (oid, node)
+        # The unique id is "<entity id>_<device class>_<device name>"
+        name = node.props["device_name"].val
+        strings_size += len(name.encode()) + len(oid) + len(entity_id.encode()) + 2 + \
+            len(name.encode())
+
+    with open(args.output, "w") as f:
+        f.write("/* Generated by gen_entity_keys.py, do not edit */\n\n")
+        f.write("#ifndef ESPHOME_ENTITY_KEYS_H\n#define ESPHOME_ENTITY_KEYS_H\n\n")
+        for key, (oid, node) in sorted(keys.items()):
+            f.write(f"/* {node.path} */\n")
+            f.write(f"#define ESPHOME_ENTITY_KEY_{oid} 0x{key:08x}U\n")
+            f.write(f"#define ESPHOME_ENTITY_KEY_NAME_{oid} k{key:08x}\n")
+        f.write(f"\n#define ESPHOME_ENTITY_COUNT {len(keys)}\n")
+        f.write(f"#define ESPHOME_ENTITY_STRINGS_SIZE {strings_size}\n")
+        f.write("\n#endif /* ESPHOME_ENTITY_KEYS_H */\n")
+
+
+if __name__ == "__main__":
+    main()
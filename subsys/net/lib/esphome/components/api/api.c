@@ -95,6 +95,7 @@ char *get_mac_address_string(char *buffer, int size)
 int HelloRequestCb(const struct device *dev, HelloRequest *request)
 {
 	const struct esphome_config *config = dev->config;
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(dev);
 	char buffer[MAX_DEVICE_NAME];
 
 	ARG_UNUSED(request);
@@ -106,17 +107,27 @@ int HelloRequestCb(const struct device *dev, HelloRequest *request)
 	response.api_version_major = config->api_version_major;
 	response.api_version_minor = config->api_version_minor;
 
+	if (conn->state == ESPHOME_RPC_CONN_HELLO) {
+		conn->state = ESPHOME_RPC_CONN_CONNECT;
+	}
+
 	return HelloResponseWrite(dev, &response);
 }
 
 int ConnectRequestCb(const struct device *dev, ConnectRequest *request)
 {
 	const struct esphome_config *config = dev->config;
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(dev);
 	ConnectResponse response = CONNECT_RESPONSE__INIT;
 
 	if (config->password) {
 		response.invalid_password = strcmp(config->password, request->password);
 	}
+
+	if (!response.invalid_password) {
+		conn->state = ESPHOME_RPC_CONN_CONNECTED;
+	}
+
 	return ConnectResponseWrite(dev, &response);
 }
 
@@ -144,31 +155,148 @@ int DeviceInfoRequestCb(const struct device *dev)
 	return DeviceInfoResponseWrite(dev, &response);
 }
 
-int ListEntitiesRequestCb(const struct device *dev)
+/*
+ * List the entities from the index pos, which is updated as they are. When
+ * the TX buffer is full, the request is handled again from there.
+ */
+static int esphome_list_entities(const struct device *dev, size_t *pos)
 {
+	size_t index = 0;
+	int ret;
+
 	STRUCT_SECTION_FOREACH(esphome_entity, entity) {
-		entity->list_entity(dev, entity);
+		if (index++ < *pos) {
+			continue;
+		}
+
+		ret = entity->list_entity(dev, entity);
+		if (ret) {
+			return ret;
+		}
+		(*pos)++;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_ESPHOME_RPC_LIST_ENTITIES_CACHE
+/*
+ * Entities don't change after boot, their responses are encoded only once.
+ * The cache is sized from the strings of the entities, counted when the
+ * keys are generated, and the fields and framing of each response.
+ */
+#define LIST_ENTITIES_CACHE_SIZE                                                                   \
+	(ESPHOME_ENTITY_STRINGS_SIZE +                                                             \
+	 ESPHOME_ENTITY_COUNT * CONFIG_ESPHOME_RPC_LIST_ENTITIES_CACHE_ENTRY_SIZE)
+static uint8_t list_entities_cache[MAX(LIST_ENTITIES_CACHE_SIZE, 1)];
+/* 0 until the cache is built, -ENOSPC if the responses don't fit */
+static int list_entities_len;
+
+int ListEntitiesRequestCb(const struct device *dev)
+{
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(dev);
+	size_t pos = 0;
+	int ret;
+
+	if (!list_entities_len) {
+		esphome_rpc_capture_start(dev, list_entities_cache, sizeof(list_entities_cache));
+		(void)esphome_list_entities(dev, &pos);
+		list_entities_len = esphome_rpc_capture_stop(dev);
+		if (list_entities_len < 0) {
+			LOG_WRN("ListEntities responses don't fit in the cache, "
+				"increase CONFIG_ESPHOME_RPC_LIST_ENTITIES_CACHE_ENTRY_SIZE");
+		}
+	}
+
+	if (list_entities_len > 0) {
+		/* The whole cache is a single step */
+		if (!conn->reply_pos) {
+			ret = esphome_rpc_send_raw(dev, list_entities_cache, list_entities_len);
+			if (ret) {
+				return ret;
+			}
+			conn->reply_pos = 1;
+		}
+	} else {
+		ret = esphome_list_entities(dev, &conn->reply_pos);
+		if (ret) {
+			return ret;
+		}
 	}
 
 	return ListEntitiesDoneResponseWrite(dev);
 }
+#else
+int ListEntitiesRequestCb(const struct device *dev)
+{
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(dev);
+	int ret;
+
+	ret = esphome_list_entities(dev, &conn->reply_pos);
+	if (ret) {
+		return ret;
+	}
+
+	return ListEntitiesDoneResponseWrite(dev);
+}
+#endif
 
 #ifdef CONFIG_ESPHOME_COMPONENT_SWITCH
+/*
+ * Switch commands received together, only used by the API thread. They are
+ * applied by an event, handled once the requests already received are.
+ */
+static struct esphome_switch_batch switch_batch;
+
+static void esphome_switch_batch_handler(const struct device *dev,
+					 struct esphome_rpc_event *event)
+{
+	int ret;
+
+	ret = esphome_switch_batch_apply(&switch_batch);
+	if (ret) {
+		LOG_ERR("Failed to apply the switch commands (%d)", ret);
+	}
+
+	/* The switches that failed publish the state they kept */
+	for (size_t i = 0; i < switch_batch.switch_count; i++) {
+		ret = esphome_switch_publish_state(switch_batch.switches[i].entity);
+		if (ret) {
+			LOG_ERR("Failed to publish the state of %s (%d)",
+				switch_batch.switches[i].dev->name, ret);
+		}
+	}
+
+	esphome_switch_batch_init(&switch_batch);
+}
+
+static struct esphome_rpc_event switch_batch_event = {
+	.handler = esphome_switch_batch_handler,
+};
+
 int SwitchCommandRequestCb(const struct device *dev, SwitchCommandRequest *request)
 {
-	const struct device *switch_dev;
-	SwitchStateResponse response = SWITCH_STATE_RESPONSE__INIT;
+	const struct esphome_entity *entity;
 
-	switch_dev = find_device_entity_by_key(request->key);
-	if (!switch_dev) {
+	entity = find_entity_by_key(request->key);
+	if (!entity) {
 		return -ENODEV;
 	}
 
-	esphome_switch_set_state(switch_dev, request->state);
-	esphome_switch_get_state(switch_dev, &response.state);
-	response.key = request->key;
+	if (!esphome_switch_batch_add_entity(&switch_batch, entity, request->state)) {
+		esphome_rpc_post(dev, &switch_batch_event);
+		return 0;
+	}
+
+	esphome_switch_set_state(entity->dev, request->state);
 
-	return SwitchStateResponseWrite(dev, &response);
+	/*
+	 * Switches changing asynchronously, like the H-bridges, publish their
+	 * state once the change completes, it may not be known yet.
+	 */
+	(void)esphome_switch_publish_state(entity);
+
+	return 0;
 }
 #endif
 
@@ -186,31 +314,46 @@ int ButtonCommandRequestCb(const struct device *dev, ButtonCommandRequest *reque
 }
 #endif
 
-int LightCommandRequestCb(const struct device *dev, LightCommandRequest *request)
+int SubscribeStatesRequestCb(const struct device *dev)
 {
-	ARG_UNUSED(dev);
-	ARG_UNUSED(request);
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(dev);
+
+	/* Handled again when the states don't fit, only those not sent are then */
+	if (conn->reply_pos) {
+		return esphome_entity_resend_states(dev);
+	}
 
-	return -ENOTSUP;
+	conn->subscriptions |= ESPHOME_RPC_SUBSCRIBE_STATES;
+	conn->reply_pos = 1;
+
+	return esphome_entity_send_states(dev);
 }
 
-int SubscribeStatesRequestCb(const struct device *dev)
+int ResendStatesCb(const struct device *dev)
 {
-	ARG_UNUSED(dev);
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(dev);
 
-	return 0;
+	if (!(conn->subscriptions & ESPHOME_RPC_SUBSCRIBE_STATES)) {
+		return 0;
+	}
+
+	return esphome_entity_resend_states(dev);
 }
 
 int SubscribeHomeassistantServicesRequestCb(const struct device *dev)
 {
-	ARG_UNUSED(dev);
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(dev);
+
+	conn->subscriptions |= ESPHOME_RPC_SUBSCRIBE_HA_SERVICES;
 
 	return 0;
 }
 
 int SubscribeHomeAssistantStatesRequestCb(const struct device *dev)
 {
-	ARG_UNUSED(dev);
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(dev);
+
+	conn->subscriptions |= ESPHOME_RPC_SUBSCRIBE_HA_STATES;
 
 	return 0;
 }
@@ -16,22 +16,15 @@ LOG_MODULE_DECLARE(ESPHome, CONFIG_ESPHOME_LOG_LEVEL);
 
 #include <esphome/components/entity.h>
 
-uint32_t fnv1_hash(const char *str)
-{
-	uint32_t hash = 2166136261UL;
-	unsigned int i;
+static void esphome_entity_state_changed(const struct device *api_dev,
+					 struct esphome_rpc_event *event);
 
-	for (i = 0; i < (strlen(str) + 1); i++) {
-		hash *= 16777619UL;
-		hash ^= str[i];
-	}
-	return hash;
-}
 int esphome_entity_init(const struct device *api_dev)
 {
 	STRUCT_SECTION_FOREACH(esphome_entity, entity) {
-		entity->data->key = fnv1_hash(entity->config->object_id);
 		entity->data->api_dev = api_dev;
+		entity->data->entity = entity;
+		entity->data->event.handler = esphome_entity_state_changed;
 	}
 	return 0;
 }
@@ -55,11 +48,26 @@ int _string_copy_safe(char *dest, const char *src, size_t len)
 	return ret;
 }
 
-const struct device *find_device_entity_by_key(uint32_t key)
+/* Entities are sorted by key in their iterable section */
+const struct esphome_entity *find_entity_by_key(uint32_t key)
 {
-	STRUCT_SECTION_FOREACH(esphome_entity, entity) {
-		if (entity->data->key == key) {
-			return entity->dev;
+	struct esphome_entity *entity;
+	int lo = 0;
+	int hi;
+
+	STRUCT_SECTION_COUNT(esphome_entity, &hi);
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+
+		STRUCT_SECTION_GET(esphome_entity, mid, &entity);
+		if (entity->key == key) {
+			return entity;
+		}
+
+		if (entity->key < key) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
 		}
 	}
 
@@ -67,6 +75,146 @@ const struct device *find_device_entity_by_key(uint32_t key)
 	return NULL;
 }
 
+const struct device *find_device_entity_by_key(uint32_t key)
+{
+	const struct esphome_entity *entity = find_entity_by_key(key);
+
+	return entity ? entity->dev : NULL;
+}
+
+struct esphome_entity_push {
+	const struct esphome_entity *entity;
+	/* Snapshot of the state, the publisher may update it meanwhile */
+	union esphome_entity_state state;
+	bool force;
+};
+
+static int esphome_entity_push_state(const struct device *api_dev, int conn_id, void *user_data)
+{
+	const struct esphome_entity_push *push = user_data;
+	const struct esphome_entity *entity = push->entity;
+	struct esphome_entity_data *data = entity->data;
+	int ret;
+
+	if (!push->force && (data->sent_mask & BIT(conn_id)) &&
+	    data->sent[conn_id].raw == push->state.raw) {
+		return 0;
+	}
+
+	ret = entity->send_state(api_dev, entity, push->state);
+	if (ret) {
+		/* Sent again by esphome_entity_resend_states() */
+		data->sent_mask &= ~BIT(conn_id);
+		return ret;
+	}
+
+	data->sent[conn_id] = push->state;
+	data->sent_mask |= BIT(conn_id);
+
+	return 0;
+}
+
+/* Runs in the API thread, which is the only one writing to the clients */
+static void esphome_entity_state_changed(const struct device *api_dev,
+					 struct esphome_rpc_event *event)
+{
+	struct esphome_entity_data *data = CONTAINER_OF(event, struct esphome_entity_data, event);
+	struct esphome_entity_push push = {
+		.entity = data->entity,
+		.state = data->state,
+		.force = atomic_clear(&data->force),
+	};
+
+	esphome_rpc_foreach_conn(api_dev, ESPHOME_RPC_SUBSCRIBE_STATES, esphome_entity_push_state,
+				 &push);
+}
+
+/*
+ * Update the state of the entity. It is sent by the API thread to the
+ * clients subscribed to states that don't have it yet, or to all of them
+ * with force. The caller never blocks on the clients: states published
+ * before the API thread handles them are coalesced, the latest one is sent.
+ * The on_value automation of the entity runs first, in the caller context.
+ */
+int esphome_entity_publish(const struct esphome_entity *entity, union esphome_entity_state state,
+			   bool force)
+{
+	struct esphome_entity_data *data = entity->data;
+
+	if (entity->config->on_value) {
+		entity->config->on_value(entity->dev);
+	}
+
+	if (!data->api_dev) {
+		return -ENODEV;
+	}
+
+	data->state = state;
+	data->has_state = true;
+	if (force) {
+		atomic_set(&data->force, 1);
+	}
+	esphome_rpc_post(data->api_dev, &data->event);
+
+	return 0;
+}
+
+/*
+ * Send the known state of every entity to the client that has just subscribed.
+ * The states which don't fit in its TX buffer are then sent by
+ * esphome_entity_resend_states().
+ */
+int esphome_entity_send_states(const struct device *api_dev)
+{
+	int conn_id = esphome_rpc_get_conn_id(api_dev);
+
+	if (conn_id < 0) {
+		return conn_id;
+	}
+
+	esphome_rpc_lock(api_dev);
+	STRUCT_SECTION_FOREACH(esphome_entity, entity) {
+		entity->data->sent_mask &= ~BIT(conn_id);
+	}
+	esphome_rpc_unlock(api_dev);
+
+	return esphome_entity_resend_states(api_dev);
+}
+
+/*
+ * Send the states the client doesn't have, e.g. dropped while its TX buffer
+ * was full. Only the latest state of each entity is sent.
+ */
+int esphome_entity_resend_states(const struct device *api_dev)
+{
+	int conn_id = esphome_rpc_get_conn_id(api_dev);
+	int ret = 0;
+
+	if (conn_id < 0) {
+		return conn_id;
+	}
+
+	esphome_rpc_lock(api_dev);
+	STRUCT_SECTION_FOREACH(esphome_entity, entity) {
+		struct esphome_entity_push push = {
+			.entity = entity,
+			.state = entity->data->state,
+		};
+
+		if (!entity->send_state || !entity->data->has_state) {
+			continue;
+		}
+
+		ret = esphome_entity_push_state(api_dev, conn_id, &push);
+		if (ret) {
+			break;
+		}
+	}
+	esphome_rpc_unlock(api_dev);
+
+	return ret;
+}
+
 char *esphome_build_unique_id(const char *base_name, char *buffer, int len)
 {
 	struct net_if *iface;
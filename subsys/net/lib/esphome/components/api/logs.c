@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT nabucasa_esphome_api
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include <esphome/components/api.h>
+
+/*
+ * Log backend streaming the log messages to the API clients subscribed to
+ * logs. The messages are formatted by the log thread into a ring buffer and
+ * sent by the API thread. The ring buffer has a single producer and a single
+ * consumer so it needs no lock, and nothing waits: when it is full, messages
+ * are dropped and counted.
+ */
+
+struct esphome_log_record {
+	uint8_t level;
+	uint16_t len;
+};
+
+struct esphome_log_line {
+	LogLevel level;
+	const char *text;
+};
+
+static const struct device *const esphome_logs_api_dev = DEVICE_DT_INST_GET(0);
+
+RING_BUF_DECLARE(esphome_logs_ring, CONFIG_ESPHOME_API_LOGS_BUFFER_SIZE);
+/* Messages dropped because the ring buffer was full */
+static atomic_t esphome_logs_dropped;
+/* Highest level requested by a client, the messages above are not formatted */
+static atomic_t esphome_logs_level;
+static bool esphome_logs_panic;
+
+static void esphome_logs_send(const struct device *api_dev, struct esphome_rpc_event *event);
+
+static struct esphome_rpc_event esphome_logs_event = {
+	.handler = esphome_logs_send,
+};
+
+/* Only used by the log thread */
+static uint8_t esphome_log_line_buf[CONFIG_ESPHOME_API_LOGS_LINE_SIZE];
+static size_t esphome_log_line_len;
+static uint8_t esphome_log_output_buf[32];
+
+static const LogLevel esphome_log_levels[] = {
+	/* Raw messages, e.g. printk() */
+	[LOG_LEVEL_NONE] = LOG_LEVEL__LOG_LEVEL_INFO,
+	[LOG_LEVEL_ERR] = LOG_LEVEL__LOG_LEVEL_ERROR,
+	[LOG_LEVEL_WRN] = LOG_LEVEL__LOG_LEVEL_WARN,
+	[LOG_LEVEL_INF] = LOG_LEVEL__LOG_LEVEL_INFO,
+	[LOG_LEVEL_DBG] = LOG_LEVEL__LOG_LEVEL_DEBUG,
+};
+
+static int esphome_log_output_func(uint8_t *data, size_t length, void *ctx)
+{
+	size_t len = MIN(length, sizeof(esphome_log_line_buf) - esphome_log_line_len);
+
+	ARG_UNUSED(ctx);
+
+	/* Longer lines are truncated */
+	memcpy(esphome_log_line_buf + esphome_log_line_len, data, len);
+	esphome_log_line_len += len;
+
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(esphome_log_output, esphome_log_output_func, esphome_log_output_buf,
+		  sizeof(esphome_log_output_buf));
+
+static void esphome_logs_put(LogLevel level, const uint8_t *text, size_t len)
+{
+	struct esphome_log_record record = {
+		.level = level,
+		.len = len,
+	};
+
+	if (ring_buf_space_get(&esphome_logs_ring) < sizeof(record) + len) {
+		atomic_inc(&esphome_logs_dropped);
+		return;
+	}
+
+	ring_buf_put(&esphome_logs_ring, (uint8_t *)&record, sizeof(record));
+	ring_buf_put(&esphome_logs_ring, text, len);
+}
+
+static void esphome_log_backend_process(const struct log_backend *const backend,
+					union log_msg_generic *msg)
+{
+	uint8_t level = log_msg_get_level(&msg->log);
+	LogLevel esphome_level = esphome_log_levels[MIN(level, LOG_LEVEL_DBG)];
+
+	ARG_UNUSED(backend);
+
+	if (esphome_logs_panic || esphome_level > atomic_get(&esphome_logs_level)) {
+		return;
+	}
+
+	esphome_log_line_len = 0;
+	log_output_msg_process(&esphome_log_output, &msg->log,
+			       LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_CRLF_NONE);
+	esphome_logs_put(esphome_level, esphome_log_line_buf, esphome_log_line_len);
+
+	/* Log messages may be processed before the API is initialized */
+	if (device_is_ready(esphome_logs_api_dev)) {
+		esphome_rpc_post(esphome_logs_api_dev, &esphome_logs_event);
+	}
+}
+
+static void esphome_log_backend_dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	atomic_add(&esphome_logs_dropped, cnt);
+}
+
+static void esphome_log_backend_panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+
+	/* The API thread won't run anymore */
+	esphome_logs_panic = true;
+}
+
+static const struct log_backend_api esphome_log_backend_api = {
+	.process = esphome_log_backend_process,
+	.dropped = esphome_log_backend_dropped,
+	.panic = esphome_log_backend_panic,
+};
+
+LOG_BACKEND_DEFINE(esphome_log_backend, esphome_log_backend_api, true);
+
+static int esphome_logs_send_conn(const struct device *api_dev, int conn_id, void *user_data)
+{
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(api_dev);
+	const struct esphome_log_line *line = user_data;
+	SubscribeLogsResponse response = SUBSCRIBE_LOGS_RESPONSE__INIT;
+	char note[48];
+
+	if (line->level > conn->log_level) {
+		return 0;
+	}
+
+	if (conn->logs_dropped) {
+		snprintk(note, sizeof(note), "%u log messages dropped", conn->logs_dropped);
+		response.level = LOG_LEVEL__LOG_LEVEL_WARN;
+		response.message = note;
+		if (SubscribeLogsResponseWrite(api_dev, &response)) {
+			conn->logs_dropped++;
+			return 0;
+		}
+		conn->logs_dropped = 0;
+	}
+
+	response.level = line->level;
+	response.message = (char *)line->text;
+	if (SubscribeLogsResponseWrite(api_dev, &response)) {
+		/* Not an error, the client is told how many it missed */
+		conn->logs_dropped++;
+	}
+
+	return 0;
+}
+
+static int esphome_logs_max_level(const struct device *api_dev, int conn_id, void *user_data)
+{
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(api_dev);
+	LogLevel *level = user_data;
+
+	*level = MAX(*level, conn->log_level);
+
+	return 0;
+}
+
+static void esphome_logs_broadcast(const struct device *api_dev, LogLevel level, const char *text)
+{
+	struct esphome_log_line line = {
+		.level = level,
+		.text = text,
+	};
+
+	esphome_rpc_foreach_conn(api_dev, ESPHOME_RPC_SUBSCRIBE_LOGS, esphome_logs_send_conn,
+				 &line);
+}
+
+/* Runs in the API thread */
+static void esphome_logs_send(const struct device *api_dev, struct esphome_rpc_event *event)
+{
+	char text[CONFIG_ESPHOME_API_LOGS_LINE_SIZE + 1];
+	struct esphome_log_record record;
+	LogLevel level = LOG_LEVEL__LOG_LEVEL_NONE;
+	atomic_val_t dropped;
+
+	ARG_UNUSED(event);
+
+	dropped = atomic_clear(&esphome_logs_dropped);
+	if (dropped) {
+		snprintk(text, sizeof(text), "%ld log messages dropped", (long)dropped);
+		esphome_logs_broadcast(api_dev, LOG_LEVEL__LOG_LEVEL_WARN, text);
+	}
+
+	/* The log thread writes the record before its text */
+	while (ring_buf_peek(&esphome_logs_ring, (uint8_t *)&record, sizeof(record)) ==
+		       sizeof(record) &&
+	       ring_buf_size_get(&esphome_logs_ring) >= sizeof(record) + record.len) {
+		ring_buf_get(&esphome_logs_ring, NULL, sizeof(record));
+		ring_buf_get(&esphome_logs_ring, (uint8_t *)text, record.len);
+		text[record.len] = '\0';
+		esphome_logs_broadcast(api_dev, record.level, text);
+	}
+
+	/* Stop formatting the messages nobody asks for anymore */
+	esphome_rpc_foreach_conn(api_dev, ESPHOME_RPC_SUBSCRIBE_LOGS, esphome_logs_max_level,
+				 &level);
+	atomic_set(&esphome_logs_level, level);
+}
+
+int SubscribeLogsRequestCb(const struct device *dev, SubscribeLogsRequest *msg)
+{
+	struct esphome_rpc_conn *conn = esphome_rpc_get_conn(dev);
+
+	conn->subscriptions |= ESPHOME_RPC_SUBSCRIBE_LOGS;
+	conn->log_level = msg->level;
+	conn->logs_dropped = 0;
+
+	if (msg->level > atomic_get(&esphome_logs_level)) {
+		atomic_set(&esphome_logs_level, msg->level);
+	}
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "esphome_arena.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(esphome_rpc, CONFIG_ESPHOME_RPC_LOG_LEVEL);
+
+static void *arena_alloc(void *allocator_data, size_t size)
+{
+	return esphome_arena_alloc(allocator_data, size);
+}
+
+static void arena_free(void *allocator_data, void *pointer)
+{
+	esphome_arena_free(allocator_data, pointer);
+}
+
+void esphome_arena_init(struct esphome_arena *arena, uint8_t *buf, size_t size)
+{
+	arena->buf = buf;
+	arena->size = size;
+	arena->allocator.alloc = arena_alloc;
+	arena->allocator.free = arena_free;
+	arena->allocator.allocator_data = arena;
+	arena->fallbacks = 0;
+	arena->failures = 0;
+	esphome_arena_reset(arena);
+}
+
+void *esphome_arena_alloc(struct esphome_arena *arena, size_t size)
+{
+	size_t offset = ROUND_UP(arena->used, sizeof(void *));
+	void *ptr;
+
+	if (size > arena->size || offset > arena->size - size) {
+		LOG_DBG("Arena exhausted, allocating %zu bytes from heap", size);
+		arena->fallbacks++;
+		ptr = k_malloc(size);
+		if (!ptr) {
+			arena->failures++;
+		}
+		return ptr;
+	}
+
+	arena->last = arena->buf + offset;
+	arena->used = offset + size;
+
+	return arena->last;
+}
+
+void esphome_arena_free(struct esphome_arena *arena, void *pointer)
+{
+	uint8_t *ptr = pointer;
+
+	if (!ptr) {
+		return;
+	}
+
+	if (ptr < arena->buf || ptr >= arena->buf + arena->size) {
+		k_free(ptr);
+		return;
+	}
+
+	/* Only the last block can be reclaimed before the arena is reset */
+	if (ptr == arena->last) {
+		arena->used = ptr - arena->buf;
+		arena->last = NULL;
+	}
+}
+
+void esphome_arena_reset(struct esphome_arena *arena)
+{
+	arena->used = 0;
+	arena->last = NULL;
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ZEPHYR_ESPHOME_ARENA_H__
+#define __ZEPHYR_ESPHOME_ARENA_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <protobuf-c/protobuf-c.h>
+
+/*
+ * Bump allocator used to decode and encode the messages of a connection.
+ * Everything allocated during a request/response cycle is released at once
+ * by esphome_arena_reset(). When the arena is full, allocations fall back
+ * to the kernel heap.
+ */
+struct esphome_arena {
+	uint8_t *buf;
+	size_t size;
+	size_t used;
+	/* Last block allocated, the only one that can be given back */
+	uint8_t *last;
+	/* Allocations which didn't fit and went to the heap, never reset */
+	uint32_t fallbacks;
+	/* Allocations which failed, even from the heap, never reset */
+	uint32_t failures;
+	ProtobufCAllocator allocator;
+};
+
+void esphome_arena_init(struct esphome_arena *arena, uint8_t *buf, size_t size);
+void *esphome_arena_alloc(struct esphome_arena *arena, size_t size);
+void esphome_arena_free(struct esphome_arena *arena, void *pointer);
+void esphome_arena_reset(struct esphome_arena *arena);
+
+#endif /* __ZEPHYR_ESPHOME_ARENA_H__ */
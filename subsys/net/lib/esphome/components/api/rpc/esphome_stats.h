@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ZEPHYR_ESPHOME_RPC_STATS_H__
+#define __ZEPHYR_ESPHOME_RPC_STATS_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+
+/* Bucket i counts the durations below 2^(i + 4) us, the last one the others */
+#define ESPHOME_RPC_STATS_BUCKETS 8
+
+enum esphome_rpc_stats_time {
+	/* Unpacking a request */
+	ESPHOME_RPC_STATS_DECODE,
+	/* Handling a request, including the encoding of the replies */
+	ESPHOME_RPC_STATS_HANDLE,
+	/* Packing a message */
+	ESPHOME_RPC_STATS_ENCODE,
+	ESPHOME_RPC_STATS_TIMES,
+};
+
+struct esphome_rpc_counters {
+	uint32_t rx_frames;
+	uint32_t rx_bytes;
+	/* Frames queued for the clients */
+	uint32_t tx_frames;
+	uint32_t tx_bytes;
+	/* Frames dropped because the client TX buffer was full, or too large */
+	uint32_t tx_dropped;
+};
+
+/* Durations in us */
+struct esphome_rpc_histogram {
+	uint32_t count;
+	uint32_t max;
+	uint64_t total;
+	uint32_t buckets[ESPHOME_RPC_STATS_BUCKETS];
+};
+
+struct esphome_rpc_msg_stats {
+	uint32_t msg_id;
+	struct esphome_rpc_counters counters;
+	struct esphome_rpc_histogram times[ESPHOME_RPC_STATS_TIMES];
+};
+
+struct esphome_rpc_totals {
+	struct esphome_rpc_counters counters;
+	uint32_t decode_errors;
+	/* Allocations which didn't fit in an arena and went to the heap */
+	uint32_t alloc_fallbacks;
+	/* Allocations which failed, even from the heap */
+	uint32_t alloc_failures;
+	/* Time spent handling requests, in us */
+	uint64_t handle_time;
+};
+
+struct esphome_rpc_data;
+
+#ifdef CONFIG_ESPHOME_RPC_STATS
+
+struct esphome_rpc_stats {
+	struct esphome_rpc_totals totals;
+	/* Reset when a client connects */
+	struct esphome_rpc_counters conns[CONFIG_ESPHOME_RPC_MAX_CONNECTIONS];
+	/* Message types, in the order they were first seen */
+	size_t msg_count;
+	struct esphome_rpc_msg_stats msgs[CONFIG_ESPHOME_RPC_STATS_MSG_TYPES];
+};
+
+static inline uint32_t esphome_rpc_stats_now(void)
+{
+	return k_cycle_get_32();
+}
+
+/* Used by the RPC layer, with the API lock held */
+void esphome_rpc_stats_frame(struct esphome_rpc_data *rpc_data, int conn_id, bool tx,
+			     uint32_t msg_id, size_t len);
+void esphome_rpc_stats_dropped(struct esphome_rpc_data *rpc_data, int conn_id, uint32_t msg_id);
+void esphome_rpc_stats_time(struct esphome_rpc_data *rpc_data, uint32_t msg_id,
+			    enum esphome_rpc_stats_time time, uint32_t cycles);
+void esphome_rpc_stats_decode_error(struct esphome_rpc_data *rpc_data);
+void esphome_rpc_stats_conn_reset(struct esphome_rpc_data *rpc_data, int conn_id);
+
+/* Can be called from any thread, never waits for the API thread */
+void esphome_rpc_stats_get(const struct device *dev, struct esphome_rpc_stats *stats);
+void esphome_rpc_stats_get_totals(const struct device *dev, struct esphome_rpc_totals *totals);
+void esphome_rpc_stats_reset(const struct device *dev);
+
+#else
+
+static inline uint32_t esphome_rpc_stats_now(void)
+{
+	return 0;
+}
+
+static inline void esphome_rpc_stats_frame(struct esphome_rpc_data *rpc_data, int conn_id,
+					   bool tx, uint32_t msg_id, size_t len)
+{
+}
+
+static inline void esphome_rpc_stats_dropped(struct esphome_rpc_data *rpc_data, int conn_id,
+					     uint32_t msg_id)
+{
+}
+
+static inline void esphome_rpc_stats_time(struct esphome_rpc_data *rpc_data, uint32_t msg_id,
+					  enum esphome_rpc_stats_time time, uint32_t cycles)
+{
+}
+
+static inline void esphome_rpc_stats_decode_error(struct esphome_rpc_data *rpc_data)
+{
+}
+
+static inline void esphome_rpc_stats_conn_reset(struct esphome_rpc_data *rpc_data, int conn_id)
+{
+}
+
+#endif /* CONFIG_ESPHOME_RPC_STATS */
+
+#endif /* __ZEPHYR_ESPHOME_RPC_STATS_H__ */
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ZEPHYR_ESPHOME_RPC_TRACE_H__
+#define __ZEPHYR_ESPHOME_RPC_TRACE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/toolchain.h>
+
+/* "ESPT", little endian */
+#define ESPHOME_TRACE_MAGIC   0x54505345
+#define ESPHOME_TRACE_VERSION 1
+
+enum esphome_trace_type {
+	/* Frames received from the client */
+	ESPHOME_TRACE_RX,
+	/* Frames queued for the client */
+	ESPHOME_TRACE_TX,
+	/* Connection accepted, no data */
+	ESPHOME_TRACE_OPEN,
+	/* Connection closed, no data */
+	ESPHOME_TRACE_CLOSE,
+};
+
+/*
+ * A trace is a file header followed by records, each followed by the first
+ * caplen bytes of its frames. Every field is little endian.
+ */
+struct esphome_trace_file_header {
+	uint32_t magic;
+	uint16_t version;
+	/* Frames longer than this are truncated */
+	uint16_t snaplen;
+} __packed;
+
+struct esphome_trace_record {
+	/* Microseconds since boot */
+	uint64_t timestamp;
+	/* Length of the frames */
+	uint32_t len;
+	/* Length of the frames traced */
+	uint16_t caplen;
+	uint8_t conn;
+	/* enum esphome_trace_type */
+	uint8_t type;
+} __packed;
+
+#ifdef CONFIG_ESPHOME_RPC_TRACE
+
+/* Trace one or more frames, given as a header and a body which may be empty */
+void esphome_trace(enum esphome_trace_type type, int conn_id, const uint8_t *hdr, size_t hdr_len,
+		   const uint8_t *body, size_t body_len);
+
+#else
+
+static inline void esphome_trace(enum esphome_trace_type type, int conn_id, const uint8_t *hdr,
+				 size_t hdr_len, const uint8_t *body, size_t body_len)
+{
+}
+
+#endif
+
+#endif /* __ZEPHYR_ESPHOME_RPC_TRACE_H__ */
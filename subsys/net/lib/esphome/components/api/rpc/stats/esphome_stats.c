@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+
+#include "esphome_rpc.h"
+#include "esphome_stats.h"
+
+/*
+ * The statistics are only updated by the API thread, the spinlock lets the
+ * other threads read them without taking the API lock, held while a whole
+ * batch of requests is handled.
+ */
+
+/* Returns NULL once the table is full, these types only count in the totals */
+static struct esphome_rpc_msg_stats *esphome_rpc_stats_msg(struct esphome_rpc_stats *stats,
+							    uint32_t msg_id)
+{
+	struct esphome_rpc_msg_stats *msg;
+
+	for (size_t i = 0; i < stats->msg_count; i++) {
+		if (stats->msgs[i].msg_id == msg_id) {
+			return &stats->msgs[i];
+		}
+	}
+
+	if (stats->msg_count == ARRAY_SIZE(stats->msgs)) {
+		return NULL;
+	}
+
+	msg = &stats->msgs[stats->msg_count++];
+	memset(msg, 0, sizeof(*msg));
+	msg->msg_id = msg_id;
+
+	return msg;
+}
+
+static void esphome_rpc_counters_add(struct esphome_rpc_counters *counters, bool tx, size_t len)
+{
+	if (tx) {
+		counters->tx_frames++;
+		counters->tx_bytes += len;
+	} else {
+		counters->rx_frames++;
+		counters->rx_bytes += len;
+	}
+}
+
+void esphome_rpc_stats_frame(struct esphome_rpc_data *rpc_data, int conn_id, bool tx,
+			     uint32_t msg_id, size_t len)
+{
+	struct esphome_rpc_stats *stats = &rpc_data->stats;
+	k_spinlock_key_t key = k_spin_lock(&rpc_data->stats_lock);
+	struct esphome_rpc_msg_stats *msg = esphome_rpc_stats_msg(stats, msg_id);
+
+	esphome_rpc_counters_add(&stats->totals.counters, tx, len);
+	esphome_rpc_counters_add(&stats->conns[conn_id], tx, len);
+	if (msg) {
+		esphome_rpc_counters_add(&msg->counters, tx, len);
+	}
+	k_spin_unlock(&rpc_data->stats_lock, key);
+}
+
+void esphome_rpc_stats_dropped(struct esphome_rpc_data *rpc_data, int conn_id, uint32_t msg_id)
+{
+	struct esphome_rpc_stats *stats = &rpc_data->stats;
+	k_spinlock_key_t key = k_spin_lock(&rpc_data->stats_lock);
+	struct esphome_rpc_msg_stats *msg = esphome_rpc_stats_msg(stats, msg_id);
+
+	stats->totals.counters.tx_dropped++;
+	stats->conns[conn_id].tx_dropped++;
+	if (msg) {
+		msg->counters.tx_dropped++;
+	}
+	k_spin_unlock(&rpc_data->stats_lock, key);
+}
+
+void esphome_rpc_stats_time(struct esphome_rpc_data *rpc_data, uint32_t msg_id,
+			    enum esphome_rpc_stats_time time, uint32_t cycles)
+{
+	struct esphome_rpc_stats *stats = &rpc_data->stats;
+	uint32_t us = k_cyc_to_us_floor32(cycles);
+	struct esphome_rpc_histogram *histogram;
+	struct esphome_rpc_msg_stats *msg;
+	k_spinlock_key_t key;
+	int bucket;
+
+	/* Bucket i holds [2^(i + 3), 2^(i + 4)) us, the first one also below */
+	bucket = us < 16 ? 0 : MIN(31 - __builtin_clz(us) - 3, ESPHOME_RPC_STATS_BUCKETS - 1);
+
+	key = k_spin_lock(&rpc_data->stats_lock);
+	if (time == ESPHOME_RPC_STATS_HANDLE) {
+		stats->totals.handle_time += us;
+	}
+
+	msg = esphome_rpc_stats_msg(stats, msg_id);
+	if (msg) {
+		histogram = &msg->times[time];
+		histogram->count++;
+		histogram->max = MAX(histogram->max, us);
+		histogram->total += us;
+		histogram->buckets[bucket]++;
+	}
+	k_spin_unlock(&rpc_data->stats_lock, key);
+}
+
+void esphome_rpc_stats_decode_error(struct esphome_rpc_data *rpc_data)
+{
+	k_spinlock_key_t key = k_spin_lock(&rpc_data->stats_lock);
+
+	rpc_data->stats.totals.decode_errors++;
+	k_spin_unlock(&rpc_data->stats_lock, key);
+}
+
+void esphome_rpc_stats_conn_reset(struct esphome_rpc_data *rpc_data, int conn_id)
+{
+	k_spinlock_key_t key = k_spin_lock(&rpc_data->stats_lock);
+
+	memset(&rpc_data->stats.conns[conn_id], 0, sizeof(rpc_data->stats.conns[conn_id]));
+	k_spin_unlock(&rpc_data->stats_lock, key);
+}
+
+/* The arenas count their allocation failures themselves, they are never reset */
+static void esphome_rpc_stats_arenas(struct esphome_rpc_data *rpc_data,
+				     struct esphome_rpc_totals *totals)
+{
+	totals->alloc_fallbacks = rpc_data->arena.fallbacks;
+	totals->alloc_failures = rpc_data->arena.failures;
+	for (int i = 0; i < ARRAY_SIZE(rpc_data->conns); i++) {
+		totals->alloc_fallbacks += rpc_data->conns[i].arena.fallbacks;
+		totals->alloc_failures += rpc_data->conns[i].arena.failures;
+	}
+}
+
+void esphome_rpc_stats_get(const struct device *dev, struct esphome_rpc_stats *stats)
+{
+	struct esphome_rpc_data *rpc_data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&rpc_data->stats_lock);
+
+	memcpy(stats, &rpc_data->stats, sizeof(*stats));
+	k_spin_unlock(&rpc_data->stats_lock, key);
+	esphome_rpc_stats_arenas(rpc_data, &stats->totals);
+}
+
+void esphome_rpc_stats_get_totals(const struct device *dev, struct esphome_rpc_totals *totals)
+{
+	struct esphome_rpc_data *rpc_data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&rpc_data->stats_lock);
+
+	*totals = rpc_data->stats.totals;
+	k_spin_unlock(&rpc_data->stats_lock, key);
+	esphome_rpc_stats_arenas(rpc_data, totals);
+}
+
+/* The connection counters are kept, they are reset when a client connects */
+void esphome_rpc_stats_reset(const struct device *dev)
+{
+	struct esphome_rpc_data *rpc_data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&rpc_data->stats_lock);
+
+	memset(&rpc_data->stats.totals, 0, sizeof(rpc_data->stats.totals));
+	rpc_data->stats.msg_count = 0;
+	k_spin_unlock(&rpc_data->stats_lock, key);
+}
+
+#ifdef CONFIG_ESPHOME_SHELL
+
+static const struct device *const esphome_stats_api_dev =
+	DEVICE_DT_GET_ONE(nabucasa_esphome_api);
+
+/* Only used by the shell thread, too large for its stack */
+static struct esphome_rpc_stats esphome_shell_stats;
+
+static const char *const esphome_stats_time_names[] = {
+	[ESPHOME_RPC_STATS_DECODE] = "decode",
+	[ESPHOME_RPC_STATS_HANDLE] = "handle",
+	[ESPHOME_RPC_STATS_ENCODE] = "encode",
+};
+
+static void esphome_stats_print_counters(const struct shell *sh, const char *name,
+					 const struct esphome_rpc_counters *counters)
+{
+	shell_print(sh, "%-6s %10u %10u %10u %10u %8u", name, counters->rx_frames,
+		    counters->rx_bytes, counters->tx_frames, counters->tx_bytes,
+		    counters->tx_dropped);
+}
+
+static uint32_t esphome_stats_avg(const struct esphome_rpc_histogram *histogram)
+{
+	return histogram->count ? histogram->total / histogram->count : 0;
+}
+
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	struct esphome_rpc_stats *stats = &esphome_shell_stats;
+	const struct esphome_rpc_histogram *times;
+	char name[12];
+
+	esphome_rpc_stats_get(esphome_stats_api_dev, stats);
+
+	shell_print(sh, "%-6s %10s %10s %10s %10s %8s", "Conn", "RX frames", "RX bytes",
+		    "TX frames", "TX bytes", "Dropped");
+	for (int i = 0; i < ARRAY_SIZE(stats->conns); i++) {
+		snprintk(name, sizeof(name), "%d", i);
+		esphome_stats_print_counters(sh, name, &stats->conns[i]);
+	}
+	esphome_stats_print_counters(sh, "Total", &stats->totals.counters);
+	shell_print(sh, "Decode errors: %u, arena exhausted: %u, allocation failures: %u",
+		    stats->totals.decode_errors, stats->totals.alloc_fallbacks,
+		    stats->totals.alloc_failures);
+	shell_print(sh, "Time spent handling requests: %u ms\n",
+		    (uint32_t)(stats->totals.handle_time / USEC_PER_MSEC));
+
+	shell_print(sh, "%-6s %10s %10s %10s %10s %8s %15s %15s %15s", "Msg", "RX frames",
+		    "RX bytes", "TX frames", "TX bytes", "Dropped", "decode avg/max",
+		    "handle avg/max", "encode avg/max");
+	for (size_t i = 0; i < stats->msg_count; i++) {
+		const struct esphome_rpc_msg_stats *msg = &stats->msgs[i];
+		const struct esphome_rpc_counters *counters = &msg->counters;
+
+		times = msg->times;
+		shell_print(sh, "%-6u %10u %10u %10u %10u %8u %7u/%-7u %7u/%-7u %7u/%-7u",
+			    msg->msg_id, counters->rx_frames, counters->rx_bytes,
+			    counters->tx_frames, counters->tx_bytes, counters->tx_dropped,
+			    esphome_stats_avg(&times[ESPHOME_RPC_STATS_DECODE]),
+			    times[ESPHOME_RPC_STATS_DECODE].max,
+			    esphome_stats_avg(&times[ESPHOME_RPC_STATS_HANDLE]),
+			    times[ESPHOME_RPC_STATS_HANDLE].max,
+			    esphome_stats_avg(&times[ESPHOME_RPC_STATS_ENCODE]),
+			    times[ESPHOME_RPC_STATS_ENCODE].max);
+	}
+
+	if (stats->msg_count == ARRAY_SIZE(stats->msgs)) {
+		shell_warn(sh, "Message types table full, see ESPHOME_RPC_STATS_MSG_TYPES");
+	}
+
+	return 0;
+}
+
+static int cmd_stats_histograms(const struct shell *sh, size_t argc, char **argv)
+{
+	struct esphome_rpc_stats *stats = &esphome_shell_stats;
+
+	esphome_rpc_stats_get(esphome_stats_api_dev, stats);
+
+	shell_print(sh, "%-6s %-6s %8s %8s %8s %8s %8s %8s %8s %8s", "Msg", "Time", "<16us",
+		    "<32us", "<64us", "<128us", "<256us", "<512us", "<1ms", ">=1ms");
+	for (size_t i = 0; i < stats->msg_count; i++) {
+		const struct esphome_rpc_msg_stats *msg = &stats->msgs[i];
+
+		for (int t = 0; t < ESPHOME_RPC_STATS_TIMES; t++) {
+			const uint32_t *buckets = msg->times[t].buckets;
+
+			if (!msg->times[t].count) {
+				continue;
+			}
+
+			shell_print(sh, "%-6u %-6s %8u %8u %8u %8u %8u %8u %8u %8u", msg->msg_id,
+				    esphome_stats_time_names[t], buckets[0], buckets[1],
+				    buckets[2], buckets[3], buckets[4], buckets[5], buckets[6],
+				    buckets[7]);
+		}
+	}
+
+	return 0;
+}
+
+static int cmd_stats_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	esphome_rpc_stats_reset(esphome_stats_api_dev);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_stats,
+			       SHELL_CMD(histograms, NULL, "Show the time histograms per message",
+					 cmd_stats_histograms),
+			       SHELL_CMD(reset, NULL, "Reset the statistics", cmd_stats_reset),
+			       SHELL_SUBCMD_SET_END);
+
+SHELL_SUBCMD_ADD((esphome), stats, &sub_stats, "API statistics", cmd_stats, 1, 0);
+
+#endif /* CONFIG_ESPHOME_SHELL */
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "esphome_trace.h"
+
+#ifdef CONFIG_ESPHOME_RPC_TRACE_FILE
+#include <cmdline.h>
+#include <posix_native_task.h>
+
+#include "esphome_trace_bottom.h"
+#endif
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(esphome_rpc, CONFIG_ESPHOME_RPC_LOG_LEVEL);
+
+/*
+ * Records are appended to a ring buffer, overwriting the oldest ones. Tracing
+ * only copies the start of the frames, they are decoded on the host.
+ */
+
+#define ESPHOME_TRACE_RECORD_MAX_SIZE                                                              \
+	(sizeof(struct esphome_trace_record) + CONFIG_ESPHOME_RPC_TRACE_SNAPLEN)
+
+BUILD_ASSERT(CONFIG_ESPHOME_RPC_TRACE_BUFFER_SIZE >= ESPHOME_TRACE_RECORD_MAX_SIZE,
+	     "The trace buffer must hold at least one record");
+
+static uint8_t esphome_trace_buf[CONFIG_ESPHOME_RPC_TRACE_BUFFER_SIZE];
+/* Offset of the oldest record */
+static size_t esphome_trace_tail;
+static size_t esphome_trace_used;
+/* Records overwritten before being dumped */
+static uint32_t esphome_trace_overwritten;
+static struct k_spinlock esphome_trace_lock;
+static atomic_t esphome_trace_enabled = ATOMIC_INIT(1);
+
+static void esphome_trace_copy_in(size_t offset, const uint8_t *data, size_t len)
+{
+	size_t n;
+
+	if (!len) {
+		return;
+	}
+
+	offset %= sizeof(esphome_trace_buf);
+	n = MIN(len, sizeof(esphome_trace_buf) - offset);
+	memcpy(esphome_trace_buf + offset, data, n);
+	memcpy(esphome_trace_buf, data + n, len - n);
+}
+
+static void esphome_trace_copy_out(size_t offset, uint8_t *data, size_t len)
+{
+	size_t n;
+
+	offset %= sizeof(esphome_trace_buf);
+	n = MIN(len, sizeof(esphome_trace_buf) - offset);
+	memcpy(data, esphome_trace_buf + offset, n);
+	memcpy(data + n, esphome_trace_buf, len - n);
+}
+
+/* Size of the oldest record, must be called with the lock held */
+static size_t esphome_trace_oldest_size(void)
+{
+	struct esphome_trace_record record;
+
+	esphome_trace_copy_out(esphome_trace_tail, (uint8_t *)&record, sizeof(record));
+
+	return sizeof(record) + sys_le16_to_cpu(record.caplen);
+}
+
+static void esphome_trace_drop_oldest(size_t size)
+{
+	esphome_trace_tail = (esphome_trace_tail + size) % sizeof(esphome_trace_buf);
+	esphome_trace_used -= size;
+}
+
+#ifdef CONFIG_ESPHOME_RPC_TRACE_FILE
+
+static const char *esphome_trace_path;
+static int esphome_trace_fd = -1;
+
+static void esphome_trace_file_write(const struct esphome_trace_record *record,
+				     const uint8_t *hdr, size_t hdr_len, const uint8_t *body,
+				     size_t body_len)
+{
+	struct esphome_trace_record file_record = *record;
+	size_t caplen = MIN(hdr_len + body_len, UINT16_MAX);
+
+	if (esphome_trace_fd < 0) {
+		return;
+	}
+
+	/* The file gets the whole frames */
+	file_record.caplen = sys_cpu_to_le16(caplen);
+	esphome_trace_bottom_write(esphome_trace_fd, &file_record, sizeof(file_record));
+	esphome_trace_bottom_write(esphome_trace_fd, hdr, MIN(hdr_len, caplen));
+	if (caplen > hdr_len) {
+		esphome_trace_bottom_write(esphome_trace_fd, body, caplen - hdr_len);
+	}
+}
+
+static void esphome_trace_options(void)
+{
+	static struct args_struct_t options[] = {
+		{
+			.option = "esphome-trace",
+			.name = "path",
+			.type = 's',
+			.dest = (void *)&esphome_trace_path,
+			.descript = "Write the ESPHome API trace to this file",
+		},
+		ARG_TABLE_ENDMARKER,
+	};
+
+	native_add_command_line_opts(options);
+}
+
+NATIVE_TASK(esphome_trace_options, PRE_BOOT_1, 1);
+
+static int esphome_trace_file_init(void)
+{
+	struct esphome_trace_file_header header = {
+		.magic = sys_cpu_to_le32(ESPHOME_TRACE_MAGIC),
+		.version = sys_cpu_to_le16(ESPHOME_TRACE_VERSION),
+		.snaplen = sys_cpu_to_le16(UINT16_MAX),
+	};
+
+	if (!esphome_trace_path) {
+		return 0;
+	}
+
+	esphome_trace_fd = esphome_trace_bottom_open(esphome_trace_path);
+	if (esphome_trace_fd < 0) {
+		LOG_ERR("Failed to open %s (%d)", esphome_trace_path, esphome_trace_fd);
+		return 0;
+	}
+	esphome_trace_bottom_write(esphome_trace_fd, &header, sizeof(header));
+
+	return 0;
+}
+
+SYS_INIT(esphome_trace_file_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#endif /* CONFIG_ESPHOME_RPC_TRACE_FILE */
+
+void esphome_trace(enum esphome_trace_type type, int conn_id, const uint8_t *hdr, size_t hdr_len,
+		   const uint8_t *body, size_t body_len)
+{
+	size_t caplen = MIN(hdr_len + body_len, CONFIG_ESPHOME_RPC_TRACE_SNAPLEN);
+	size_t hdr_caplen = MIN(hdr_len, caplen);
+	struct esphome_trace_record record = {
+		.timestamp = sys_cpu_to_le64(k_ticks_to_us_floor64(k_uptime_ticks())),
+		.len = sys_cpu_to_le32(hdr_len + body_len),
+		.caplen = sys_cpu_to_le16(caplen),
+		.conn = conn_id,
+		.type = type,
+	};
+	size_t size = sizeof(record) + caplen;
+	size_t head;
+	k_spinlock_key_t key;
+
+	if (!atomic_get(&esphome_trace_enabled)) {
+		return;
+	}
+
+	key = k_spin_lock(&esphome_trace_lock);
+	while (sizeof(esphome_trace_buf) - esphome_trace_used < size) {
+		esphome_trace_drop_oldest(esphome_trace_oldest_size());
+		esphome_trace_overwritten++;
+	}
+
+	head = esphome_trace_tail + esphome_trace_used;
+	esphome_trace_copy_in(head, (const uint8_t *)&record, sizeof(record));
+	esphome_trace_copy_in(head + sizeof(record), hdr, hdr_caplen);
+	esphome_trace_copy_in(head + sizeof(record) + hdr_caplen, body, caplen - hdr_caplen);
+	esphome_trace_used += size;
+	k_spin_unlock(&esphome_trace_lock, key);
+
+#ifdef CONFIG_ESPHOME_RPC_TRACE_FILE
+	esphome_trace_file_write(&record, hdr, hdr_len, body, body_len);
+#endif
+}
+
+#ifdef CONFIG_ESPHOME_SHELL
+
+/* Prefix of the dumped lines, the decoder ignores the others */
+#define ESPHOME_TRACE_DUMP_PREFIX "esphome-trace "
+
+/* Remove the oldest record and copy it into buf, returns its size or 0 if none */
+static size_t esphome_trace_pop(uint8_t *buf)
+{
+	k_spinlock_key_t key = k_spin_lock(&esphome_trace_lock);
+	size_t size = 0;
+
+	if (esphome_trace_used) {
+		size = esphome_trace_oldest_size();
+		esphome_trace_copy_out(esphome_trace_tail, buf, size);
+		esphome_trace_drop_oldest(size);
+	}
+	k_spin_unlock(&esphome_trace_lock, key);
+
+	return size;
+}
+
+static void esphome_trace_dump_line(const struct shell *sh, const void *data, size_t len)
+{
+	/* Only used by the shell thread, too large for its stack */
+	static char hex[ESPHOME_TRACE_RECORD_MAX_SIZE * 2 + 1];
+
+	bin2hex(data, len, hex, sizeof(hex));
+	shell_print(sh, ESPHOME_TRACE_DUMP_PREFIX "%s", hex);
+}
+
+static int cmd_trace_dump(const struct shell *sh, size_t argc, char **argv)
+{
+	static uint8_t record[ESPHOME_TRACE_RECORD_MAX_SIZE];
+	struct esphome_trace_file_header header = {
+		.magic = sys_cpu_to_le32(ESPHOME_TRACE_MAGIC),
+		.version = sys_cpu_to_le16(ESPHOME_TRACE_VERSION),
+		.snaplen = sys_cpu_to_le16(CONFIG_ESPHOME_RPC_TRACE_SNAPLEN),
+	};
+	size_t size;
+
+	/* The records are dumped as a trace file, one line each */
+	esphome_trace_dump_line(sh, &header, sizeof(header));
+	while ((size = esphome_trace_pop(record)) > 0) {
+		esphome_trace_dump_line(sh, record, size);
+	}
+
+	if (esphome_trace_overwritten) {
+		shell_warn(sh, "%u records were overwritten", esphome_trace_overwritten);
+		esphome_trace_overwritten = 0;
+	}
+
+	return 0;
+}
+
+static int cmd_trace_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	k_spinlock_key_t key = k_spin_lock(&esphome_trace_lock);
+
+	esphome_trace_tail = 0;
+	esphome_trace_used = 0;
+	esphome_trace_overwritten = 0;
+	k_spin_unlock(&esphome_trace_lock, key);
+
+	return 0;
+}
+
+static int cmd_trace_start(const struct shell *sh, size_t argc, char **argv)
+{
+	atomic_set(&esphome_trace_enabled, 1);
+
+	return 0;
+}
+
+static int cmd_trace_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	atomic_set(&esphome_trace_enabled, 0);
+
+	return 0;
+}
+
+static int cmd_trace_status(const struct shell *sh, size_t argc, char **argv)
+{
+	shell_print(sh, "%s, %zu/%zu bytes used, %u records overwritten",
+		    atomic_get(&esphome_trace_enabled) ? "Started" : "Stopped", esphome_trace_used,
+		    sizeof(esphome_trace_buf), esphome_trace_overwritten);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_trace,
+			       SHELL_CMD(dump, NULL, "Dump and remove the traced frames",
+					 cmd_trace_dump),
+			       SHELL_CMD(clear, NULL, "Remove the traced frames", cmd_trace_clear),
+			       SHELL_CMD(start, NULL, "Start tracing", cmd_trace_start),
+			       SHELL_CMD(stop, NULL, "Stop tracing", cmd_trace_stop),
+			       SHELL_CMD(status, NULL, "Show the trace buffer usage",
+					 cmd_trace_status),
+			       SHELL_SUBCMD_SET_END);
+
+SHELL_SUBCMD_ADD((esphome), trace, &sub_trace, "API traffic trace", NULL, 0, 0);
+
+#endif /* CONFIG_ESPHOME_SHELL */
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Built with the host libc, on the native simulator side of native_sim */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "esphome_trace_bottom.h"
+
+int esphome_trace_bottom_open(const char *path)
+{
+	int fd;
+
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	return fd;
+}
+
+void esphome_trace_bottom_write(int fd, const void *data, size_t len)
+{
+	const char *buf = data;
+	ssize_t ret;
+
+	while (len) {
+		ret = write(fd, buf, len);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			/* Tracing must not disturb the device, the trace is just cut short */
+			return;
+		}
+		buf += ret;
+		len -= ret;
+	}
+}
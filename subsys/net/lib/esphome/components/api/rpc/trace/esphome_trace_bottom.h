@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ZEPHYR_ESPHOME_RPC_TRACE_BOTTOM_H__
+#define __ZEPHYR_ESPHOME_RPC_TRACE_BOTTOM_H__
+
+#include <stddef.h>
+
+/* Host side of the trace file on native_sim, returns a file descriptor or -errno */
+int esphome_trace_bottom_open(const char *path);
+void esphome_trace_bottom_write(int fd, const void *data, size_t len);
+
+#endif /* __ZEPHYR_ESPHOME_RPC_TRACE_BOTTOM_H__ */
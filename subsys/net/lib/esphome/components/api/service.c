@@ -11,22 +11,37 @@
 
 #include <esphome/components/entity.h>
 #include <esphome/esphome.h>
+#include <esphome/workq.h>
 #include <rpc/esphome_rpc.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(ESPHome, CONFIG_ESPHOME_LOG_LEVEL);
 
-#define ESPHOME_STACK_SIZE (4096)
-#define ESPHOME_PRIORITY   (5)
-
-#define ESPHOME_SENSOR_STACK_SIZE (2048)
-
 static int esphome_init(const struct device *dev)
 {
+	esphome_rpc_init(dev);
 	esphome_entity_init(dev);
 	return 0;
 }
 
+static int esphome_net_init(void *data)
+{
+	const struct device *dev = data;
+	const struct esphome_config *config = dev->config;
+
+	return esphome_rpc_start(dev, config->port);
+}
+
+static int esphome_net_prepare(void *data, struct zsock_pollfd *fds)
+{
+	return esphome_rpc_poll_prepare(data, fds);
+}
+
+static void esphome_net_handle(void *data, struct zsock_pollfd *fds)
+{
+	esphome_rpc_poll_handle(data, fds);
+}
+
 #define DEFINE_ESPHOME(_num)                                                                       \
                                                                                                    \
 	static const struct esphome_config esphome_config_##_num = {                               \
@@ -39,14 +54,14 @@ static int esphome_init(const struct device *dev)
 		.compilation_time = __DATE__ " " __TIME__,                                         \
 		.server_info = "",                                                                 \
 	};                                                                                         \
-	static struct esphome_data esphome_data_##_num;                                            \
+	static struct esphome_rpc_data esphome_data_##_num;                                        \
                                                                                                    \
 	DEVICE_DT_INST_DEFINE(_num, esphome_init, NULL, &esphome_data_##_num,                      \
 			      &esphome_config_##_num, POST_KERNEL, CONFIG_ESPHOME_INIT_PRIORITY,   \
 			      NULL);                                                               \
                                                                                                    \
-	K_THREAD_DEFINE(esphome_tid_##_num, ESPHOME_STACK_SIZE, esphome_rpc_service,               \
-			DEVICE_DT_INST_GET(_num), DT_INST_PROP(_num, port), NULL,                  \
-			0 /* todo: set priority */, 0, 0);
+	ESPHOME_NET_SERVICE_DEFINE(esphome_api_##_num, ESPHOME_RPC_POLL_FDS, esphome_net_init,     \
+				   esphome_net_prepare, esphome_net_handle,                        \
+				   (void *)DEVICE_DT_INST_GET(_num));
 
 DT_INST_FOREACH_STATUS_OKAY(DEFINE_ESPHOME);
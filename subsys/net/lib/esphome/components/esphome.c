@@ -1,6 +1,10 @@
 #include <zephyr/device.h>
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 
+#include <esphome/esphome.h>
+#include <esphome/workq.h>
+
 #define DT_DRV_COMPAT NABUCASA_ESPHOME
 #define ESPHOME_NODE  DT_PATH(esphome)
 
@@ -19,16 +23,113 @@ DT_DEFINE_ACTION_FUNCTION(ESPHOME_NODE, on_boot);
 DT_DEFINE_ACTION_FUNCTION(ESPHOME_NODE, on_loop);
 DT_DEFINE_ACTION_FUNCTION(ESPHOME_NODE, on_shutdown);
 
-int esphome_service(void *arg1, void *arg2, void *arg3)
+/*
+ * The automations are run by the background work queue, each one scheduled
+ * for its next deadline: nothing runs, and the CPU can stay idle, until one
+ * of them is due.
+ */
+
+#if DT_NODE_HAS_PROP(ESPHOME_NODE, on_loop)
+
+static void esphome_loop(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+
+	on_loop(NULL);
+	k_work_schedule_for_queue(&esphome_background_workq, dwork,
+				  K_MSEC(DT_PROP(ESPHOME_NODE, loop_interval)));
+}
+
+static K_WORK_DELAYABLE_DEFINE(esphome_loop_work, esphome_loop);
+
+#endif
+
+#if DT_HAS_COMPAT_STATUS_OKAY(nabucasa_esphome_interval)
+
+struct esphome_interval {
+	struct k_work_delayable work;
+	void (*action)(const struct device *dev);
+	uint32_t interval;
+	uint32_t startup_delay;
+	/* Uptime at which the action is due */
+	int64_t next;
+};
+
+#define DECLARE_INTERVAL_ACTION(node_id)                                                           \
+	extern void DT_STRING_UNQUOTED(node_id, then)(const struct device *dev);
+
+#define ESPHOME_INTERVAL_INIT(node_id)                                                             \
+	{                                                                                          \
+		.action = DT_STRING_UNQUOTED(node_id, then),                                       \
+		.interval = DT_PROP(node_id, interval),                                            \
+		.startup_delay = DT_PROP(node_id, startup_delay),                                  \
+	},
+
+DT_FOREACH_STATUS_OKAY(nabucasa_esphome_interval, DECLARE_INTERVAL_ACTION)
+
+static struct esphome_interval esphome_intervals[] = {
+	DT_FOREACH_STATUS_OKAY(nabucasa_esphome_interval, ESPHOME_INTERVAL_INIT)};
+
+static void esphome_interval_schedule(struct esphome_interval *interval)
+{
+	k_work_schedule_for_queue(&esphome_background_workq, &interval->work,
+				  K_MSEC(MAX(interval->next - k_uptime_get(), 0)));
+}
+
+static void esphome_interval_run(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct esphome_interval *interval = CONTAINER_OF(dwork, struct esphome_interval, work);
+
+	interval->action(NULL);
+
+	/* Due at a fixed rate, unless the action took longer than the interval */
+	interval->next = MAX(interval->next + interval->interval, k_uptime_get());
+	esphome_interval_schedule(interval);
+}
+
+static void esphome_intervals_start(void)
+{
+	int64_t now = k_uptime_get();
+
+	for (int i = 0; i < ARRAY_SIZE(esphome_intervals); i++) {
+		struct esphome_interval *interval = &esphome_intervals[i];
+
+		k_work_init_delayable(&interval->work, esphome_interval_run);
+		interval->next = now + interval->startup_delay;
+		esphome_interval_schedule(interval);
+	}
+}
+
+#else
+
+static void esphome_intervals_start(void)
+{
+}
+
+#endif
+
+static void esphome_boot(struct k_work *work)
 {
 	on_boot(NULL);
-	while (1) {
-		on_loop(NULL);
-		k_sleep(K_MSEC(16));
-	};
+	esphome_intervals_start();
+#if DT_NODE_HAS_PROP(ESPHOME_NODE, on_loop)
+	k_work_schedule_for_queue(&esphome_background_workq, &esphome_loop_work, K_NO_WAIT);
+#endif
+}
+
+static K_WORK_DEFINE(esphome_boot_work, esphome_boot);
+
+static int esphome_service_init(void)
+{
+	k_work_submit_to_queue(&esphome_background_workq, &esphome_boot_work);
+
+	return 0;
 }
 
-#define ESPHOME_STACK_SIZE (4096)
+SYS_INIT(esphome_service_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
 
-K_THREAD_DEFINE(esphome_tid, ESPHOME_STACK_SIZE, esphome_service, NULL, NULL, NULL,
-		0 /* todo: set priority */, 0, 0);
\ No newline at end of file
+void esphome_shutdown(void)
+{
+	on_shutdown(NULL);
+}
@@ -3,11 +3,37 @@
 
 #include <esphome/components/logger.h>
 
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(esphome_logger, CONFIG_ESPHOME_LOG_LEVEL);
+
+#define ESPHOME_LOGGER_LINE_SIZE 128
+
+/*
+ * Go through the Zephyr logging, so that the message is output by the log
+ * thread (and sent to the API clients) rather than by the caller.
+ */
 void esphome_logger_log(const char *level, const char *tag, const char *format, ...)
 {
+	char msg[ESPHOME_LOGGER_LINE_SIZE];
 	va_list args;
+
 	va_start(args, format);
-	vprintf(format, args);
-	printf("\n");
+	vsnprintf(msg, sizeof(msg), format, args);
 	va_end(args);
+
+	switch (level[0]) {
+	case 'E':
+		LOG_ERR("[%s] %s", tag, msg);
+		break;
+	case 'W':
+		LOG_WRN("[%s] %s", tag, msg);
+		break;
+	case 'D':
+	case 'V':
+		LOG_DBG("[%s] %s", tag, msg);
+		break;
+	default:
+		LOG_INF("[%s] %s", tag, msg);
+		break;
+	}
 }
@@ -1,20 +1,36 @@
+#include <strings.h>
+
 #include <zephyr/dfu/mcuboot.h>
 
 #include <zephyr/net/net_ip.h>
 #include <zephyr/net/socket.h>
 
 #include <zephyr/dfu/flash_img.h>
+#include <zephyr/drivers/flash.h>
 #include <zephyr/storage/flash_map.h>
 
 #include <zephyr/sys/reboot.h>
+#include <zephyr/sys/util.h>
+
+#include <mbedtls/md5.h>
+
+#include <esphome/esphome.h>
+#include <esphome/workq.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(ESPHomeOTA);
 
 #include "esphome_ota.h"
+#ifdef CONFIG_ESPHOME_OTA_DEFLATE
+#include "esphome_ota_inflate.h"
+#endif
+#ifdef CONFIG_ESPHOME_OTA_DELTA
+#include "esphome_ota_delta.h"
+#endif
 
 #define USE_OTA_VERSION 2
 #define OTA_BLOCK_SIZE  8192
+#define OTA_MD5_SIZE    16
 
 int esphome_ota_read_magic(int socket)
 {
@@ -52,6 +68,28 @@ int esphome_ota_send_version(int socket)
 	return 0;
 }
 
+static bool esphome_ota_deflate(uint8_t ota_features)
+{
+	return IS_ENABLED(CONFIG_ESPHOME_OTA_DEFLATE) &&
+	       (ota_features & OTA_FEATURE_SUPPORTS_DEFLATE);
+}
+
+static bool esphome_ota_delta(uint8_t ota_features)
+{
+	return IS_ENABLED(CONFIG_ESPHOME_OTA_DELTA) && (ota_features & OTA_FEATURE_SUPPORTS_DELTA);
+}
+
+/* Window of the compressed image, 0 if it isn't compressed */
+static uint8_t esphome_ota_window_bits(uint8_t ota_features)
+{
+#ifdef CONFIG_ESPHOME_OTA_DEFLATE
+	if (esphome_ota_deflate(ota_features)) {
+		return CONFIG_ESPHOME_OTA_DEFLATE_WINDOW_BITS;
+	}
+#endif
+	return 0;
+}
+
 int esphome_ota_read_features(int socket, uint8_t *ota_features)
 {
 	char buf[1];
@@ -65,7 +103,24 @@ int esphome_ota_read_features(int socket, uint8_t *ota_features)
 	*ota_features = buf[0];
 
 	/* Send ack */
-	buf[0] = OTA_RESPONSE_HEADER_OK;
+	if (esphome_ota_delta(*ota_features)) {
+		buf[0] = OTA_RESPONSE_SUPPORTS_DELTA;
+	} else if (esphome_ota_deflate(*ota_features)) {
+		buf[0] = OTA_RESPONSE_SUPPORTS_DEFLATE;
+	} else {
+		buf[0] = OTA_RESPONSE_HEADER_OK;
+	}
+	ret = zsock_send(socket, buf, sizeof(buf), 0);
+	if (ret != sizeof(buf)) {
+		return -EIO;
+	}
+
+	if (buf[0] == OTA_RESPONSE_HEADER_OK) {
+		return 0;
+	}
+
+	/* The client compresses the image with a window the device can hold */
+	buf[0] = esphome_ota_window_bits(*ota_features);
 	ret = zsock_send(socket, buf, sizeof(buf), 0);
 	if (ret != sizeof(buf)) {
 		return -EIO;
@@ -126,6 +181,7 @@ int esphome_ota_send_prepare_ok(int socket)
 int esphome_ota_read_md5(int socket, char *md5_buf, int size)
 {
 	uint8_t error_code = 0;
+	uint8_t ack = OTA_RESPONSE_BIN_MD5_OK;
 	int ret;
 
 	ret = zsock_recv(socket, md5_buf, size - 1, ZSOCK_MSG_WAITALL);
@@ -136,8 +192,7 @@ int esphome_ota_read_md5(int socket, char *md5_buf, int size)
 	md5_buf[size - 1] = '\0';
 
 	/* Send ack */
-	md5_buf[0] = OTA_RESPONSE_BIN_MD5_OK;
-	ret = zsock_send(socket, md5_buf, 1, 0);
+	ret = zsock_send(socket, &ack, 1, 0);
 	if (ret != 1) {
 		return -EIO;
 	}
@@ -196,13 +251,512 @@ int esphome_ota_read_ack(int socket)
 	return 0;
 }
 
+/*
+ * The image is received in CONFIG_ESPHOME_OTA_BUFFERS buffers, written to
+ * the flash by the writer thread while the next ones are received.
+ */
+
+struct esphome_ota_chunk {
+	uint8_t *buf;
+	size_t len;
+	/*
+	 * Last chunk of the image, or of an aborted update if buf is NULL. A
+	 * chunk with neither only wakes the writer up.
+	 */
+	bool last;
+};
+
+static uint8_t esphome_ota_bufs[CONFIG_ESPHOME_OTA_BUFFERS][CONFIG_ESPHOME_OTA_BUFFER_SIZE];
+K_MSGQ_DEFINE(esphome_ota_free_bufs, sizeof(uint8_t *), CONFIG_ESPHOME_OTA_BUFFERS, 4);
+/* Every buffer, the wake up and the abort chunks */
+K_MSGQ_DEFINE(esphome_ota_chunks, sizeof(struct esphome_ota_chunk), CONFIG_ESPHOME_OTA_BUFFERS + 2,
+	      4);
+/* Given by the writer once the last chunk is handled */
+static K_SEM_DEFINE(esphome_ota_written, 0, 1);
+static struct flash_img_context *esphome_ota_writer_ctx;
+/* Digest of the image written to the flash */
+static mbedtls_md5_context *esphome_ota_writer_md5;
+/* First write error of the update */
+static atomic_t esphome_ota_write_ret;
+/* Size of the image written so far */
+static size_t esphome_ota_written_size;
+
+/*
+ * With CONFIG_ESPHOME_OTA_PRE_ERASE, the writer erases the sectors of the
+ * image, then the one of the MCUboot trailer, while it has nothing to write,
+ * so that the data is only programmed. Owned by the writer once the update
+ * is started.
+ */
+static size_t esphome_ota_erased;
+static size_t esphome_ota_erase_end;
+static bool esphome_ota_erase_trailer;
+
+static bool esphome_ota_erase_pending(void)
+{
+	return !atomic_get(&esphome_ota_write_ret) &&
+	       (esphome_ota_erased < esphome_ota_erase_end || esphome_ota_erase_trailer);
+}
+
+static int esphome_ota_erase_sector(void)
+{
+	const struct flash_area *fa = esphome_ota_writer_ctx->flash_area;
+	bool trailer = esphome_ota_erased >= esphome_ota_erase_end;
+	size_t offset = trailer ? fa->fa_size - 1 : esphome_ota_erased;
+	struct flash_pages_info info;
+	size_t start;
+	int ret;
+
+	ret = flash_get_page_info_by_offs(flash_area_get_device(fa), fa->fa_off + offset, &info);
+	if (ret) {
+		return ret;
+	}
+
+	start = info.start_offset - fa->fa_off;
+	if (trailer) {
+		esphome_ota_erase_trailer = false;
+		/* Already erased with the image */
+		if (start < esphome_ota_erased) {
+			return 0;
+		}
+	}
+
+	ret = flash_area_erase(fa, start, info.size);
+	if (ret) {
+		return ret;
+	}
+
+	if (!trailer) {
+		esphome_ota_erased = start + info.size;
+	}
+
+	return 0;
+}
+
+static void esphome_ota_erase_next(void)
+{
+	int ret;
+
+	ret = esphome_ota_erase_sector();
+	if (ret) {
+		LOG_ERR("Failed to erase the slot (%d)", ret);
+		atomic_set(&esphome_ota_write_ret, ret);
+	}
+}
+
+/* Returns the next chunk, erasing the slot while waiting for it */
+static void esphome_ota_writer_get(struct esphome_ota_chunk *chunk)
+{
+	/* A sector at a time, the chunks come first */
+	while (esphome_ota_erase_pending()) {
+		if (!k_msgq_get(&esphome_ota_chunks, chunk, K_NO_WAIT)) {
+			return;
+		}
+		esphome_ota_erase_next();
+	}
+
+	k_msgq_get(&esphome_ota_chunks, chunk, K_FOREVER);
+}
+
+static void esphome_ota_flash_write(const uint8_t *data, size_t len, bool flush)
+{
+	int ret;
+
+	/* The data only waits for the erase of its own sectors */
+	esphome_ota_written_size += len;
+	while (esphome_ota_erase_pending() &&
+	       esphome_ota_erased < MIN(esphome_ota_written_size, esphome_ota_erase_end)) {
+		esphome_ota_erase_next();
+	}
+
+	/* The data following an error is dropped */
+	if (atomic_get(&esphome_ota_write_ret)) {
+		return;
+	}
+
+	ret = flash_img_buffered_write(esphome_ota_writer_ctx, data, len, flush);
+	if (ret) {
+		LOG_ERR("Failed to write the image (%d)", ret);
+		atomic_set(&esphome_ota_write_ret, ret);
+		return;
+	}
+
+	ret = mbedtls_md5_update(esphome_ota_writer_md5, data, len);
+	if (ret) {
+		atomic_set(&esphome_ota_write_ret, ret);
+	}
+}
+
+#ifdef CONFIG_ESPHOME_OTA_DELTA
+
+/* The image written is the one rebuilt from the patch and the primary slot */
+static struct esphome_ota_delta esphome_ota_delta_state;
+static bool esphome_ota_writer_delta;
+
+static int esphome_ota_delta_flash_write(struct esphome_ota_delta *delta, const uint8_t *data,
+					 size_t len)
+{
+	/* The size of the new image is known once the patch header is applied */
+	if (IS_ENABLED(CONFIG_ESPHOME_OTA_PRE_ERASE)) {
+		esphome_ota_erase_end = delta->new_size;
+	}
+
+	esphome_ota_flash_write(data, len, false);
+
+	return atomic_get(&esphome_ota_write_ret);
+}
+
+#endif /* CONFIG_ESPHOME_OTA_DELTA */
+
+/* Writes the image, received or inflated, applying it as a patch in delta mode */
+static void esphome_ota_image_write(const uint8_t *data, size_t len)
+{
+#ifdef CONFIG_ESPHOME_OTA_DELTA
+	int ret;
+
+	if (esphome_ota_writer_delta) {
+		if (atomic_get(&esphome_ota_write_ret)) {
+			return;
+		}
+
+		ret = esphome_ota_delta_write(&esphome_ota_delta_state, data, len);
+		if (ret && !atomic_get(&esphome_ota_write_ret)) {
+			LOG_ERR("Failed to apply the patch (%d)", ret);
+			atomic_set(&esphome_ota_write_ret, ret);
+		}
+		return;
+	}
+#endif
+	esphome_ota_flash_write(data, len, false);
+}
+
+/* Called once the whole image is written */
+static void esphome_ota_image_end(void)
+{
+	esphome_ota_flash_write(NULL, 0, true);
+}
+
+/* Handles the last chunk, once its data is written */
+static void esphome_ota_writer_end(struct esphome_ota_chunk *chunk)
+{
+#ifdef CONFIG_ESPHOME_OTA_DELTA
+	int ret;
+
+	if (esphome_ota_writer_delta) {
+		ret = esphome_ota_delta_finish(&esphome_ota_delta_state);
+		/* An aborted update is incomplete anyway */
+		if (ret && chunk->buf && !atomic_get(&esphome_ota_write_ret)) {
+			LOG_ERR("Incomplete patch (%d)", ret);
+			atomic_set(&esphome_ota_write_ret, ret);
+		}
+	}
+#endif
+
+	if (!chunk->buf) {
+		/* Aborted, the sectors left are not needed anymore */
+		esphome_ota_erase_end = esphome_ota_erased;
+		esphome_ota_erase_trailer = false;
+	}
+
+	/* The trailer must be erased before boot_request_upgrade() */
+	while (esphome_ota_erase_pending()) {
+		esphome_ota_erase_next();
+	}
+
+	k_sem_give(&esphome_ota_written);
+}
+
+static void esphome_ota_write(struct esphome_ota_chunk *chunk)
+{
+	if (chunk->buf) {
+		esphome_ota_image_write(chunk->buf, chunk->len);
+		k_msgq_put(&esphome_ota_free_bufs, &chunk->buf, K_NO_WAIT);
+		if (chunk->last) {
+			esphome_ota_image_end();
+		}
+	}
+
+	if (chunk->last) {
+		esphome_ota_writer_end(chunk);
+	}
+}
+
+#ifdef CONFIG_ESPHOME_OTA_DEFLATE
+
+/*
+ * A compressed image is its size, 4 bytes big endian as the other sizes of
+ * the protocol, followed by the raw deflate stream. The writer pulls the
+ * stream from the chunks.
+ */
+static struct esphome_ota_writer_inflate {
+	struct esphome_ota_inflate inflate;
+	struct esphome_ota_chunk chunk;
+	size_t pos;
+} esphome_ota_inflate_state;
+
+static bool esphome_ota_writer_deflate;
+
+static int esphome_ota_inflate_read_byte(struct esphome_ota_inflate *inflate)
+{
+	struct esphome_ota_writer_inflate *state =
+		CONTAINER_OF(inflate, struct esphome_ota_writer_inflate, inflate);
+
+	while (state->pos == state->chunk.len) {
+		/* The stream is truncated */
+		if (state->chunk.last) {
+			return state->chunk.buf ? -EBADMSG : -ECANCELED;
+		}
+
+		if (state->chunk.buf) {
+			k_msgq_put(&esphome_ota_free_bufs, &state->chunk.buf, K_NO_WAIT);
+		}
+
+		esphome_ota_writer_get(&state->chunk);
+		state->pos = 0;
+	}
+
+	return state->chunk.buf[state->pos++];
+}
+
+static int esphome_ota_inflate_write(struct esphome_ota_inflate *inflate, const uint8_t *data,
+				     size_t len)
+{
+	esphome_ota_image_write(data, len);
+
+	return atomic_get(&esphome_ota_write_ret);
+}
+
+static int esphome_ota_writer_inflate(void)
+{
+	struct esphome_ota_writer_inflate *state = &esphome_ota_inflate_state;
+	size_t image_size = 0;
+	int byte;
+	int ret;
+
+	for (int i = 0; i < 4; i++) {
+		byte = esphome_ota_inflate_read_byte(&state->inflate);
+		if (byte < 0) {
+			return byte;
+		}
+		image_size = (image_size << 8) | byte;
+	}
+
+	if (image_size > esphome_ota_writer_ctx->flash_area->fa_size) {
+		return -EFBIG;
+	}
+
+	if (IS_ENABLED(CONFIG_ESPHOME_OTA_PRE_ERASE)) {
+		esphome_ota_erase_end = image_size;
+	}
+
+	ret = esphome_ota_inflate(&state->inflate);
+	if (ret) {
+		return ret;
+	}
+
+	/* Nothing must follow the stream */
+	if (!state->chunk.last || state->pos != state->chunk.len ||
+	    state->inflate.total != image_size) {
+		return -EBADMSG;
+	}
+
+	esphome_ota_image_end();
+
+	return 0;
+}
+
+/* Consumes the chunks of the update, starting with chunk */
+static void esphome_ota_inflate_chunks(struct esphome_ota_chunk *chunk)
+{
+	struct esphome_ota_writer_inflate *state = &esphome_ota_inflate_state;
+	int ret;
+
+	state->inflate.read_byte = esphome_ota_inflate_read_byte;
+	state->inflate.write = esphome_ota_inflate_write;
+	state->chunk = *chunk;
+	state->pos = 0;
+
+	ret = esphome_ota_writer_inflate();
+	if (ret && !atomic_get(&esphome_ota_write_ret)) {
+		LOG_ERR("Failed to inflate the image (%d)", ret);
+		atomic_set(&esphome_ota_write_ret, ret);
+	}
+
+	/* After an error, the receiver stops at the next chunk */
+	while (!state->chunk.last) {
+		if (state->chunk.buf) {
+			k_msgq_put(&esphome_ota_free_bufs, &state->chunk.buf, K_NO_WAIT);
+		}
+		esphome_ota_writer_get(&state->chunk);
+	}
+
+	if (state->chunk.buf) {
+		k_msgq_put(&esphome_ota_free_bufs, &state->chunk.buf, K_NO_WAIT);
+	}
+	esphome_ota_writer_end(&state->chunk);
+}
+
+#endif /* CONFIG_ESPHOME_OTA_DEFLATE */
+
+static void esphome_ota_writer(void *arg1, void *arg2, void *arg3)
+{
+	struct esphome_ota_chunk chunk;
+
+	while (1) {
+		esphome_ota_writer_get(&chunk);
+
+#ifdef CONFIG_ESPHOME_OTA_DEFLATE
+		if (esphome_ota_writer_deflate && chunk.buf) {
+			esphome_ota_inflate_chunks(&chunk);
+			continue;
+		}
+#endif
+		esphome_ota_write(&chunk);
+	}
+}
+
+K_THREAD_DEFINE(esphome_ota_writer_tid, CONFIG_ESPHOME_OTA_WRITER_STACK_SIZE, esphome_ota_writer,
+		NULL, NULL, NULL, CONFIG_ESPHOME_OTA_WRITER_PRIORITY, 0, 0);
+
+/*
+ * Prepares the writer for an update, and starts erasing the slot. The image
+ * written to the flash, inflated and patched as negotiated, is hashed into
+ * md5.
+ */
+static int esphome_ota_writer_start(struct flash_img_context *ctx, size_t ota_size,
+				    mbedtls_md5_context *md5, uint8_t ota_features)
+{
+	struct esphome_ota_chunk chunk = {0};
+
+	/* The writer is idle, the previous update waited for it */
+	esphome_ota_writer_ctx = ctx;
+	esphome_ota_writer_md5 = md5;
+#ifdef CONFIG_ESPHOME_OTA_DEFLATE
+	esphome_ota_writer_deflate = esphome_ota_deflate(ota_features);
+#endif
+#ifdef CONFIG_ESPHOME_OTA_DELTA
+	esphome_ota_writer_delta = esphome_ota_delta(ota_features);
+	if (esphome_ota_writer_delta) {
+		int ret;
+
+		esphome_ota_delta_state.write = esphome_ota_delta_flash_write;
+		esphome_ota_delta_state.max_new_size = ctx->flash_area->fa_size;
+		ret = esphome_ota_delta_init(&esphome_ota_delta_state);
+		if (ret) {
+			return ret;
+		}
+	}
+#endif
+	atomic_clear(&esphome_ota_write_ret);
+	esphome_ota_written_size = 0;
+	esphome_ota_erased = 0;
+	esphome_ota_erase_end = IS_ENABLED(CONFIG_ESPHOME_OTA_PRE_ERASE) ? ota_size : 0;
+	esphome_ota_erase_trailer = IS_ENABLED(CONFIG_ESPHOME_OTA_PRE_ERASE);
+	k_sem_reset(&esphome_ota_written);
+	k_msgq_purge(&esphome_ota_free_bufs);
+	for (int i = 0; i < ARRAY_SIZE(esphome_ota_bufs); i++) {
+		uint8_t *buf = esphome_ota_bufs[i];
+
+		k_msgq_put(&esphome_ota_free_bufs, &buf, K_NO_WAIT);
+	}
+
+	k_msgq_put(&esphome_ota_chunks, &chunk, K_NO_WAIT);
+
+	return 0;
+}
+
+/* Waits for the writer to be done with the update, aborting it first if asked */
+static int esphome_ota_writer_stop(bool abort)
+{
+	struct esphome_ota_chunk chunk = {
+		.last = true,
+	};
+
+	if (abort) {
+		k_msgq_put(&esphome_ota_chunks, &chunk, K_NO_WAIT);
+	}
+
+	k_sem_take(&esphome_ota_written, K_FOREVER);
+
+	return atomic_get(&esphome_ota_write_ret);
+}
+
+/*
+ * Receives the image into the writer started by esphome_ota_writer_start(),
+ * and waits for it to be written.
+ */
+static int esphome_ota_receive(int socket, size_t ota_size)
+{
+	struct esphome_ota_chunk chunk;
+	size_t total = 0;
+	size_t size_acknowledged = 0;
+	uint8_t ack = OTA_RESPONSE_CHUNK_OK;
+	int write_ret;
+	int ret = 0;
+
+	while (total < ota_size) {
+		/* Waits for the writer when all the buffers are in use */
+		k_msgq_get(&esphome_ota_free_bufs, &chunk.buf, K_FOREVER);
+		chunk.len = MIN(CONFIG_ESPHOME_OTA_BUFFER_SIZE, ota_size - total);
+		ret = esphome_ota_read_data(socket, (char *)chunk.buf, chunk.len);
+		if (ret) {
+			break;
+		}
+
+		total += chunk.len;
+		chunk.last = total == ota_size;
+		k_msgq_put(&esphome_ota_chunks, &chunk, K_NO_WAIT);
+
+		ret = atomic_get(&esphome_ota_write_ret);
+		if (ret) {
+			break;
+		}
+
+		while (size_acknowledged + OTA_BLOCK_SIZE <= total ||
+		       (total == ota_size && size_acknowledged < ota_size)) {
+			if (zsock_send(socket, &ack, 1, 0) != 1) {
+				ret = -EIO;
+				break;
+			}
+			size_acknowledged += OTA_BLOCK_SIZE;
+		}
+		if (ret) {
+			break;
+		}
+	}
+
+	/* The image must be completely written, or the writer stopped, before returning */
+	write_ret = esphome_ota_writer_stop(total < ota_size);
+
+	return ret ? ret : write_ret;
+}
+
+static int esphome_ota_check_md5(mbedtls_md5_context *md5, const char *expected)
+{
+	uint8_t digest[OTA_MD5_SIZE];
+	char hex[OTA_MD5_SIZE * 2 + 1];
+	int ret;
+
+	ret = mbedtls_md5_finish(md5, digest);
+	if (ret) {
+		return ret;
+	}
+
+	bin2hex(digest, sizeof(digest), hex, sizeof(hex));
+	if (strncasecmp(hex, expected, sizeof(hex))) {
+		LOG_ERR("MD5 mismatch, expected %s, got %s", expected, hex);
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
 int esphome_ota_run(int socket, struct flash_img_context *ctx)
 {
 	size_t ota_size;
 	uint8_t ota_features;
-	char buf[1024];
-	size_t total = 0;
-	size_t size_acknowledged = 0;
+	char md5_hex[OTA_MD5_SIZE * 2 + 1];
+	mbedtls_md5_context md5;
+	char buf[1];
 
 	int ret;
 
@@ -237,42 +791,53 @@ int esphome_ota_run(int socket, struct flash_img_context *ctx)
 		goto error;
 	}
 
-	/* TODO: check memory size */
+	if (!ota_size || ota_size > ctx->flash_area->fa_size) {
+		LOG_ERR("Invalid ota size %zu", ota_size);
+		buf[0] = OTA_RESPONSE_ERROR_UPDATE_PREPARE;
+		zsock_send(socket, buf, 1, 0);
+		ret = -EFBIG;
+		goto error;
+	}
 
-	ret = esphome_ota_send_prepare_ok(socket);
+	mbedtls_md5_init(&md5);
+	ret = mbedtls_md5_starts(&md5);
 	if (ret) {
+		mbedtls_md5_free(&md5);
 		goto error;
 	}
 
-	ret = esphome_ota_read_md5(socket, buf, 32 + 1);
+	/* The slot is erased while the client sends the MD5 and the data */
+	ret = esphome_ota_writer_start(ctx, ota_size, &md5, ota_features);
 	if (ret) {
+		buf[0] = OTA_RESPONSE_ERROR_UPDATE_PREPARE;
+		zsock_send(socket, buf, 1, 0);
+		mbedtls_md5_free(&md5);
 		goto error;
 	}
 
-	while (total < ota_size) {
-		size_t requested = MIN(sizeof(buf), ota_size - total);
-		ret = esphome_ota_read_data(socket, buf, requested);
-		if (ret) {
-			goto error;
-		}
-
-		/* TODO: write data to flash */
-		bool last = (ota_size - total) <= sizeof(buf) ? true : false;
-		if (flash_img_buffered_write(ctx, buf, requested, last) != 0) {
-			goto error;
-		}
+	ret = esphome_ota_send_prepare_ok(socket);
+	if (ret == 0) {
+		ret = esphome_ota_read_md5(socket, md5_hex, sizeof(md5_hex));
+	}
+	if (ret) {
+		esphome_ota_writer_stop(true);
+		mbedtls_md5_free(&md5);
+		goto error;
+	}
 
-		total += requested;
-		while (size_acknowledged + OTA_BLOCK_SIZE <= total ||
-		       (total == ota_size && size_acknowledged < ota_size)) {
-			buf[0] = OTA_RESPONSE_CHUNK_OK;
-			ret = zsock_send(socket, buf, 1, 0);
-			if (ret != 1) {
-				goto error;
-			}
-			size_acknowledged += OTA_BLOCK_SIZE;
+	/* The MD5 is the one of the image written, inflated and patched */
+	ret = esphome_ota_receive(socket, ota_size);
+	if (ret == 0) {
+		ret = esphome_ota_check_md5(&md5, md5_hex);
+		if (ret == -EBADMSG) {
+			buf[0] = OTA_RESPONSE_ERROR_MD5_MISMATCH;
+			zsock_send(socket, buf, 1, 0);
 		}
 	}
+	mbedtls_md5_free(&md5);
+	if (ret) {
+		goto error;
+	}
 
 	buf[0] = OTA_RESPONSE_RECEIVE_OK;
 	ret = zsock_send(socket, buf, 1, 0);
@@ -280,7 +845,7 @@ int esphome_ota_run(int socket, struct flash_img_context *ctx)
 		goto error;
 	}
 
-	/* TODO: check firmware md5, flash write ok, etc */
+	/* The image is written and its MD5 matches */
 	boot_request_upgrade(1);
 
 	buf[0] = OTA_RESPONSE_UPDATE_END_OK;
@@ -295,6 +860,7 @@ int esphome_ota_run(int socket, struct flash_img_context *ctx)
 	}
 
 	LOG_INF("Rebooting ...");
+	esphome_shutdown();
 	sys_reboot(SYS_REBOOT_WARM);
 
 	/* We are not supposed to reach this point */
@@ -304,19 +870,60 @@ error:
 	return ret;
 }
 
-int esphome_ota_service(void *arg1, void *arg2, void *arg3)
+#define ESPHOME_OTA_PORT 8266
+/* A stalled client must not hold the OTA session forever */
+#define ESPHOME_OTA_RECV_TIMEOUT_SEC 10
+
+static int esphome_ota_server_fd = -1;
+/* Socket of the update in progress */
+static int esphome_ota_socket;
+static struct flash_img_context esphome_ota_ctx;
+/* Set from the accept of a client until its update is done */
+static atomic_t esphome_ota_busy;
+static K_SEM_DEFINE(esphome_ota_session_sem, 0, 1);
+
+/*
+ * The update is received with blocking calls, for minutes, by its own thread
+ * rather than a shared context, so that the API clients, the sensors and the
+ * automations are served meanwhile.
+ */
+static void esphome_ota_session(void *arg1, void *arg2, void *arg3)
 {
-	int port = 8266;
+	int socket;
+	int ret;
+
+	while (1) {
+		k_sem_take(&esphome_ota_session_sem, K_FOREVER);
+		socket = esphome_ota_socket;
+
+		ret = flash_img_init(&esphome_ota_ctx);
+		if (ret == 0) {
+			ret = esphome_ota_run(socket, &esphome_ota_ctx);
+		}
+		if (ret) {
+			LOG_ERR("Downloading and flashing OTA failed!");
+		}
+
+		zsock_close(socket);
+		LOG_INF("Connection closed");
+		atomic_clear(&esphome_ota_busy);
+	}
+}
+
+K_THREAD_DEFINE(esphome_ota_session_tid, CONFIG_ESPHOME_OTA_SESSION_STACK_SIZE,
+		esphome_ota_session, NULL, NULL, NULL, CONFIG_ESPHOME_OTA_SESSION_PRIORITY, 0, 0);
+
+static int esphome_ota_init(void *data)
+{
+	int port = ESPHOME_OTA_PORT;
 
 	int opt;
 	socklen_t optlen = sizeof(int);
 	int ret;
 
 	int server_fd;
-	socklen_t len;
 	void *addrp;
 	uint16_t *portp;
-	struct sockaddr client_addr;
 	char addrstr[INET6_ADDRSTRLEN];
 
 	static struct sockaddr server_addr;
@@ -325,12 +932,6 @@ int esphome_ota_service(void *arg1, void *arg2, void *arg3)
 		boot_write_img_confirmed();
 	}
 
-	struct flash_img_context ctx;
-	ret = flash_img_init(&ctx);
-	if (ret != 0) {
-		return ret;
-	}
-
 	if (IS_ENABLED(CONFIG_NET_IPV6)) {
 		net_sin6(&server_addr)->sin6_family = AF_INET6;
 		net_sin6(&server_addr)->sin6_addr = in6addr_any;
@@ -393,31 +994,59 @@ int esphome_ota_service(void *arg1, void *arg2, void *arg3)
 
 	LOG_INF("OTA server waits for a connection on port %d...\n", port);
 
-	while (1) {
-		int socket;
+	esphome_ota_server_fd = server_fd;
 
-		len = sizeof(client_addr);
-		socket = zsock_accept(server_fd, (struct sockaddr *)&client_addr, &len);
-		if (socket < 0) {
-			LOG_DBG("accept() failed (%d)", errno);
-			continue;
-		}
+	return 0;
+}
 
-		zsock_inet_ntop(server_addr.sa_family, addrp, addrstr, sizeof(addrstr));
-		LOG_DBG("accepted connection from [%s]:%u", addrstr, ntohs(*portp));
+static int esphome_ota_prepare(void *data, struct zsock_pollfd *fds)
+{
+	fds[0].fd = esphome_ota_server_fd;
+	fds[0].events = ZSOCK_POLLIN;
 
-		ret = esphome_ota_run(socket, &ctx);
-		if (ret) {
-			LOG_ERR("Downloading and flashing OTA failed!");
-		}
+	return -1;
+}
+
+static void esphome_ota_handle(void *data, struct zsock_pollfd *fds)
+{
+	struct sockaddr client_addr;
+	socklen_t len = sizeof(client_addr);
+	struct zsock_timeval timeout = {
+		.tv_sec = ESPHOME_OTA_RECV_TIMEOUT_SEC,
+	};
+	char addrstr[INET6_ADDRSTRLEN];
+	void *addrp;
+	int socket;
+
+	if (!(fds[0].revents & ZSOCK_POLLIN)) {
+		return;
+	}
+
+	socket = zsock_accept(esphome_ota_server_fd, &client_addr, &len);
+	if (socket < 0) {
+		LOG_DBG("accept() failed (%d)", errno);
+		return;
+	}
 
+	if (client_addr.sa_family == AF_INET6) {
+		addrp = &net_sin6(&client_addr)->sin6_addr;
+	} else {
+		addrp = &net_sin(&client_addr)->sin_addr;
+	}
+	zsock_inet_ntop(client_addr.sa_family, addrp, addrstr, sizeof(addrstr));
+
+	/* The clients retry, they will get their turn */
+	if (!atomic_cas(&esphome_ota_busy, 0, 1)) {
+		LOG_WRN("Update in progress, rejecting %s", addrstr);
 		zsock_close(socket);
-		LOG_INF("Connection from %s closed\n", addrstr);
+		return;
 	}
-	return 0;
-}
 
-#define ESPHOME_STACK_SIZE (4096)
+	LOG_DBG("accepted connection from %s", addrstr);
+	(void)zsock_setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	esphome_ota_socket = socket;
+	k_sem_give(&esphome_ota_session_sem);
+}
 
-K_THREAD_DEFINE(esphome_ota_tid, ESPHOME_STACK_SIZE, esphome_ota_service, NULL, NULL, NULL,
-		0 /* todo: set priority */, 0, 0);
\ No newline at end of file
+ESPHOME_NET_SERVICE_DEFINE(esphome_ota, 1, esphome_ota_init, esphome_ota_prepare,
+			   esphome_ota_handle, NULL);
@@ -13,6 +13,10 @@ enum OTAResponseTypes {
 	OTA_RESPONSE_UPDATE_END_OK = 0x45,
 	OTA_RESPONSE_SUPPORTS_COMPRESSION = 0x46,
 	OTA_RESPONSE_CHUNK_OK = 0x47,
+	/* Followed by the window bits the raw deflate stream must use */
+	OTA_RESPONSE_SUPPORTS_DEFLATE = 0x50,
+	/* Followed by the window bits of the patch, 0 if it isn't compressed */
+	OTA_RESPONSE_SUPPORTS_DELTA = 0x51,
 
 	OTA_RESPONSE_ERROR_MAGIC = 0x80,
 	OTA_RESPONSE_ERROR_UPDATE_PREPARE = 0x81,
@@ -30,6 +34,14 @@ enum OTAResponseTypes {
 	OTA_RESPONSE_ERROR_UNKNOWN = 0xFF,
 };
 
+enum OTAFeatures {
+	OTA_FEATURE_SUPPORTS_COMPRESSION = 0x01,
+	/* Compressed image, see scripts/esphome/esphome_ota.py */
+	OTA_FEATURE_SUPPORTS_DEFLATE = 0x80,
+	/* Patch of the running image, see scripts/esphome/esphome_ota.py */
+	OTA_FEATURE_SUPPORTS_DELTA = 0x40,
+};
+
 enum OTAState {
 	OTA_COMPLETED = 0,
 	OTA_STARTED,
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include <mbedtls/md5.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(ESPHomeOTA);
+
+#include "esphome_ota_delta.h"
+
+#define DELTA_MD5_SIZE 16
+
+/* The patch only applies to the image it was made from */
+static int delta_check_old(struct esphome_ota_delta *delta, const uint8_t *md5)
+{
+	mbedtls_md5_context ctx;
+	uint8_t digest[DELTA_MD5_SIZE];
+	size_t len;
+	int ret;
+
+	mbedtls_md5_init(&ctx);
+	ret = mbedtls_md5_starts(&ctx);
+
+	for (size_t pos = 0; !ret && pos < delta->old_size; pos += len) {
+		len = MIN(sizeof(delta->buf), delta->old_size - pos);
+		ret = flash_area_read(delta->old, pos, delta->buf, len);
+		if (!ret) {
+			ret = mbedtls_md5_update(&ctx, delta->buf, len);
+		}
+	}
+
+	if (!ret) {
+		ret = mbedtls_md5_finish(&ctx, digest);
+	}
+	mbedtls_md5_free(&ctx);
+	if (ret) {
+		return ret;
+	}
+
+	if (memcmp(digest, md5, sizeof(digest))) {
+		LOG_ERR("The patch doesn't apply to the running image");
+		return -ESTALE;
+	}
+
+	return 0;
+}
+
+static int delta_parse_header(struct esphome_ota_delta *delta)
+{
+	const uint8_t *header = delta->header;
+
+	if (sys_get_le32(header) != ESPHOME_OTA_DELTA_MAGIC) {
+		return -EBADMSG;
+	}
+
+	delta->old_size = sys_get_le32(header + 4);
+	delta->new_size = sys_get_le32(header + 24);
+	if (delta->old_size > delta->old->fa_size) {
+		return -EBADMSG;
+	}
+
+	/* Rejected before anything is written */
+	if (delta->new_size > delta->max_new_size) {
+		return -EFBIG;
+	}
+
+	return delta_check_old(delta, header + 8);
+}
+
+static int delta_parse_record(struct esphome_ota_delta *delta)
+{
+	const uint8_t *record = delta->header;
+	size_t diff_len = sys_get_le32(record);
+	int64_t old_pos;
+
+	delta->extra_len = sys_get_le32(record + 4);
+	delta->seek = (int32_t)sys_get_le32(record + 8);
+
+	/*
+	 * Checked once, the diff and the extra are then applied as they come.
+	 * The lengths are compared one at a time, their sum could wrap.
+	 */
+	old_pos = (int64_t)delta->old_pos + diff_len + delta->seek;
+	if (diff_len > delta->old_size - delta->old_pos || old_pos < 0 ||
+	    old_pos > delta->old_size || diff_len > delta->new_size - delta->new_written ||
+	    delta->extra_len > delta->new_size - delta->new_written - diff_len) {
+		return -EBADMSG;
+	}
+
+	delta->remaining = diff_len;
+	delta->state = ESPHOME_OTA_DELTA_DIFF;
+
+	return 0;
+}
+
+/* Skips the empty diffs and extras */
+static void delta_advance(struct esphome_ota_delta *delta)
+{
+	if (delta->state == ESPHOME_OTA_DELTA_DIFF && !delta->remaining) {
+		delta->remaining = delta->extra_len;
+		delta->state = ESPHOME_OTA_DELTA_EXTRA;
+	}
+
+	if (delta->state == ESPHOME_OTA_DELTA_EXTRA && !delta->remaining) {
+		delta->old_pos += delta->seek;
+		delta->state = ESPHOME_OTA_DELTA_RECORD;
+	}
+}
+
+/* Returns the number of bytes of data consumed, or a negative error code */
+static int delta_consume(struct esphome_ota_delta *delta, const uint8_t *data, size_t len)
+{
+	bool header = delta->state == ESPHOME_OTA_DELTA_HEADER;
+	size_t header_size = header ? ESPHOME_OTA_DELTA_HEADER_SIZE : ESPHOME_OTA_DELTA_RECORD_SIZE;
+	int ret = 0;
+
+	switch (delta->state) {
+	case ESPHOME_OTA_DELTA_HEADER:
+	case ESPHOME_OTA_DELTA_RECORD:
+		len = MIN(len, header_size - delta->header_len);
+		memcpy(delta->header + delta->header_len, data, len);
+		delta->header_len += len;
+		if (delta->header_len < header_size) {
+			return len;
+		}
+
+		delta->header_len = 0;
+		if (header) {
+			ret = delta_parse_header(delta);
+			delta->state = ESPHOME_OTA_DELTA_RECORD;
+		} else {
+			ret = delta_parse_record(delta);
+		}
+		break;
+	case ESPHOME_OTA_DELTA_DIFF:
+		len = MIN(len, MIN(delta->remaining, sizeof(delta->buf)));
+		ret = flash_area_read(delta->old, delta->old_pos, delta->buf, len);
+		if (ret) {
+			return ret;
+		}
+
+		for (size_t i = 0; i < len; i++) {
+			delta->buf[i] += data[i];
+		}
+		ret = delta->write(delta, delta->buf, len);
+		delta->old_pos += len;
+		delta->remaining -= len;
+		delta->new_written += len;
+		break;
+	case ESPHOME_OTA_DELTA_EXTRA:
+		len = MIN(len, delta->remaining);
+		ret = delta->write(delta, data, len);
+		delta->remaining -= len;
+		delta->new_written += len;
+		break;
+	}
+
+	if (ret) {
+		return ret;
+	}
+
+	delta_advance(delta);
+
+	return len;
+}
+
+int esphome_ota_delta_init(struct esphome_ota_delta *delta)
+{
+	delta->state = ESPHOME_OTA_DELTA_HEADER;
+	delta->header_len = 0;
+	delta->old_pos = 0;
+	delta->new_size = 0;
+	delta->new_written = 0;
+
+	return flash_area_open(FIXED_PARTITION_ID(slot0_partition), &delta->old);
+}
+
+int esphome_ota_delta_write(struct esphome_ota_delta *delta, const uint8_t *data, size_t len)
+{
+	int ret;
+
+	while (len) {
+		ret = delta_consume(delta, data, len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		data += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+int esphome_ota_delta_finish(struct esphome_ota_delta *delta)
+{
+	bool complete = delta->state == ESPHOME_OTA_DELTA_RECORD && !delta->header_len &&
+			delta->new_written == delta->new_size;
+
+	flash_area_close(delta->old);
+
+	return complete ? 0 : -EBADMSG;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ESPHOME_OTA_DELTA_H
+#define ESPHOME_OTA_DELTA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/storage/flash_map.h>
+
+#define ESPHOME_OTA_DELTA_MAGIC       0x31544c44 /* "DLT1" */
+#define ESPHOME_OTA_DELTA_HEADER_SIZE 28
+#define ESPHOME_OTA_DELTA_RECORD_SIZE 12
+
+enum esphome_ota_delta_state {
+	ESPHOME_OTA_DELTA_HEADER,
+	ESPHOME_OTA_DELTA_RECORD,
+	ESPHOME_OTA_DELTA_DIFF,
+	ESPHOME_OTA_DELTA_EXTRA,
+};
+
+/*
+ * Patch applied to the image of the primary slot as it streams in, all the
+ * fields being little endian:
+ * - a header: the magic, the size and the MD5 of the old image, and the size
+ *   of the new image, on 4, 4, 16 and 4 bytes,
+ * - records: the diff and extra lengths, and the seek in the old image, on
+ *   4 bytes each, followed by the diff bytes, added to the old image ones,
+ *   and the extra bytes, copied.
+ * The new image is output through write.
+ */
+struct esphome_ota_delta {
+	int (*write)(struct esphome_ota_delta *delta, const uint8_t *data, size_t len);
+
+	const struct flash_area *old;
+	size_t old_size;
+	size_t old_pos;
+	/* Room for the new image, set by the caller */
+	size_t max_new_size;
+	size_t new_size;
+	size_t new_written;
+
+	enum esphome_ota_delta_state state;
+	/* Header or record being received */
+	uint8_t header[ESPHOME_OTA_DELTA_HEADER_SIZE];
+	size_t header_len;
+	/* Bytes left of the current diff or extra */
+	size_t remaining;
+	size_t extra_len;
+	int32_t seek;
+	uint8_t buf[64];
+};
+
+/* Opens the primary slot, write and max_new_size must be set */
+int esphome_ota_delta_init(struct esphome_ota_delta *delta);
+int esphome_ota_delta_write(struct esphome_ota_delta *delta, const uint8_t *data, size_t len);
+/* Closes the primary slot, fails if the new image is incomplete */
+int esphome_ota_delta_finish(struct esphome_ota_delta *delta);
+
+#endif /* ESPHOME_OTA_DELTA_H */
@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "esphome_ota_inflate.h"
+
+#define HUFFMAN_MAX_BITS 15
+#define LIT_CODES        286
+#define DIST_CODES       30
+#define FIXED_LIT_CODES  288
+#define WINDOW_MASK      (ESPHOME_OTA_INFLATE_WINDOW_SIZE - 1)
+
+static const uint16_t length_base[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,
+					 15, 17, 19, 23, 27, 31, 35, 43, 51,  59,
+					 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t length_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+					 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t dist_base[30] = {1,    2,    3,    4,    5,    7,     9,     13,
+				       17,   25,   33,   49,   65,   97,    129,   193,
+				       257,  385,  513,  769,  1025, 1537,  2049,  3073,
+				       4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t dist_extra[30] = {0, 0, 0, 0, 1, 1, 2,  2,  3,  3,  4,  4,  5,  5,  6,
+				       6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+/* Order of the code length code lengths */
+static const uint8_t code_length_order[19] = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+					      11, 4,  12, 3, 13, 2, 14, 1, 15};
+
+static int inflate_bits(struct esphome_ota_inflate *inflate, uint8_t count)
+{
+	uint32_t bits = inflate->bits;
+	int byte;
+
+	while (inflate->bit_count < count) {
+		byte = inflate->read_byte(inflate);
+		if (byte < 0) {
+			return byte;
+		}
+		bits |= (uint32_t)byte << inflate->bit_count;
+		inflate->bit_count += 8;
+	}
+
+	inflate->bits = bits >> count;
+	inflate->bit_count -= count;
+
+	return bits & (BIT(count) - 1);
+}
+
+static int inflate_put(struct esphome_ota_inflate *inflate, uint8_t byte)
+{
+	inflate->window[inflate->window_pos++] = byte;
+	inflate->total++;
+
+	if (inflate->window_pos == ESPHOME_OTA_INFLATE_WINDOW_SIZE) {
+		inflate->window_pos = 0;
+		return inflate->write(inflate, inflate->window, ESPHOME_OTA_INFLATE_WINDOW_SIZE);
+	}
+
+	return 0;
+}
+
+static int huffman_build(struct esphome_ota_huffman *huffman, const uint8_t *lengths, size_t n)
+{
+	uint16_t offsets[HUFFMAN_MAX_BITS + 1];
+	int left = 1;
+
+	memset(huffman->counts, 0, sizeof(huffman->counts));
+	for (size_t i = 0; i < n; i++) {
+		huffman->counts[lengths[i]]++;
+	}
+	huffman->counts[0] = 0;
+
+	/* Incomplete codes are allowed, a code is only looked up once used */
+	for (int len = 1; len <= HUFFMAN_MAX_BITS; len++) {
+		left = (left << 1) - huffman->counts[len];
+		if (left < 0) {
+			return -EBADMSG;
+		}
+	}
+
+	offsets[1] = 0;
+	for (int len = 1; len < HUFFMAN_MAX_BITS; len++) {
+		offsets[len + 1] = offsets[len] + huffman->counts[len];
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		if (lengths[i]) {
+			huffman->symbols[offsets[lengths[i]]++] = i;
+		}
+	}
+
+	return 0;
+}
+
+/* Decodes a bit at a time, trading speed for the size of the tables */
+static int huffman_decode(struct esphome_ota_inflate *inflate,
+			  const struct esphome_ota_huffman *huffman)
+{
+	int code = 0;
+	int first = 0;
+	int index = 0;
+	int bit;
+
+	for (int len = 1; len <= HUFFMAN_MAX_BITS; len++) {
+		bit = inflate_bits(inflate, 1);
+		if (bit < 0) {
+			return bit;
+		}
+
+		code |= bit;
+		if (code - huffman->counts[len] < first) {
+			return huffman->symbols[index + code - first];
+		}
+
+		index += huffman->counts[len];
+		first = (first + huffman->counts[len]) << 1;
+		code <<= 1;
+	}
+
+	return -EBADMSG;
+}
+
+static int inflate_stored(struct esphome_ota_inflate *inflate)
+{
+	uint8_t header[4];
+	uint16_t len;
+	int byte;
+	int ret;
+
+	/* The block starts on the next byte */
+	inflate->bits = 0;
+	inflate->bit_count = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(header); i++) {
+		byte = inflate->read_byte(inflate);
+		if (byte < 0) {
+			return byte;
+		}
+		header[i] = byte;
+	}
+
+	len = header[0] | (header[1] << 8);
+	/* Followed by its one's complement */
+	if ((len ^ (header[2] | (header[3] << 8))) != 0xffff) {
+		return -EBADMSG;
+	}
+
+	while (len--) {
+		byte = inflate->read_byte(inflate);
+		if (byte < 0) {
+			return byte;
+		}
+
+		ret = inflate_put(inflate, byte);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int inflate_codes(struct esphome_ota_inflate *inflate)
+{
+	int symbol;
+	int extra;
+	size_t len;
+	size_t dist;
+	int ret;
+
+	while (1) {
+		symbol = huffman_decode(inflate, &inflate->lit);
+		if (symbol < 0) {
+			return symbol;
+		}
+
+		if (symbol < 256) {
+			ret = inflate_put(inflate, symbol);
+			if (ret) {
+				return ret;
+			}
+			continue;
+		}
+
+		if (symbol == 256) {
+			return 0;
+		}
+
+		symbol -= 257;
+		if (symbol >= ARRAY_SIZE(length_base)) {
+			return -EBADMSG;
+		}
+
+		extra = inflate_bits(inflate, length_extra[symbol]);
+		if (extra < 0) {
+			return extra;
+		}
+		len = length_base[symbol] + extra;
+
+		symbol = huffman_decode(inflate, &inflate->dist);
+		if (symbol < 0) {
+			return symbol;
+		}
+		if (symbol >= ARRAY_SIZE(dist_base)) {
+			return -EBADMSG;
+		}
+
+		extra = inflate_bits(inflate, dist_extra[symbol]);
+		if (extra < 0) {
+			return extra;
+		}
+		dist = dist_base[symbol] + extra;
+
+		/* The stream was compressed with a larger window */
+		if (dist > inflate->total || dist > ESPHOME_OTA_INFLATE_WINDOW_SIZE) {
+			return -EBADMSG;
+		}
+
+		while (len--) {
+			size_t pos = (inflate->window_pos - dist) & WINDOW_MASK;
+
+			ret = inflate_put(inflate, inflate->window[pos]);
+			if (ret) {
+				return ret;
+			}
+		}
+	}
+}
+
+static int inflate_fixed(struct esphome_ota_inflate *inflate)
+{
+	uint8_t *lengths = inflate->lengths;
+	int ret;
+
+	memset(lengths, 8, 144);
+	memset(lengths + 144, 9, 256 - 144);
+	memset(lengths + 256, 7, 280 - 256);
+	memset(lengths + 280, 8, FIXED_LIT_CODES - 280);
+	ret = huffman_build(&inflate->lit, lengths, FIXED_LIT_CODES);
+	if (ret) {
+		return ret;
+	}
+
+	memset(lengths, 5, DIST_CODES);
+	ret = huffman_build(&inflate->dist, lengths, DIST_CODES);
+	if (ret) {
+		return ret;
+	}
+
+	return inflate_codes(inflate);
+}
+
+static int inflate_dynamic(struct esphome_ota_inflate *inflate)
+{
+	uint8_t *lengths = inflate->lengths;
+	int nlen, ndist, ncode;
+	int index;
+	int symbol;
+	int repeat;
+	uint8_t len;
+	int ret;
+
+	nlen = inflate_bits(inflate, 5);
+	if (nlen < 0) {
+		return nlen;
+	}
+
+	ndist = inflate_bits(inflate, 5);
+	if (ndist < 0) {
+		return ndist;
+	}
+
+	ncode = inflate_bits(inflate, 4);
+	if (ncode < 0) {
+		return ncode;
+	}
+
+	nlen += 257;
+	ndist += 1;
+	ncode += 4;
+	if (nlen > LIT_CODES || ndist > DIST_CODES) {
+		return -EBADMSG;
+	}
+
+	memset(lengths, 0, ARRAY_SIZE(code_length_order));
+	for (index = 0; index < ncode; index++) {
+		ret = inflate_bits(inflate, 3);
+		if (ret < 0) {
+			return ret;
+		}
+		lengths[code_length_order[index]] = ret;
+	}
+
+	/* Until the lengths are decoded, the literal code is the code length code */
+	ret = huffman_build(&inflate->lit, lengths, ARRAY_SIZE(code_length_order));
+	if (ret) {
+		return ret;
+	}
+
+	index = 0;
+	while (index < nlen + ndist) {
+		symbol = huffman_decode(inflate, &inflate->lit);
+		if (symbol < 0) {
+			return symbol;
+		}
+
+		if (symbol < 16) {
+			lengths[index++] = symbol;
+			continue;
+		}
+
+		len = 0;
+		if (symbol == 16) {
+			if (index == 0) {
+				return -EBADMSG;
+			}
+			len = lengths[index - 1];
+			repeat = inflate_bits(inflate, 2);
+			repeat = repeat < 0 ? repeat : repeat + 3;
+		} else if (symbol == 17) {
+			repeat = inflate_bits(inflate, 3);
+			repeat = repeat < 0 ? repeat : repeat + 3;
+		} else {
+			repeat = inflate_bits(inflate, 7);
+			repeat = repeat < 0 ? repeat : repeat + 11;
+		}
+		if (repeat < 0) {
+			return repeat;
+		}
+
+		if (index + repeat > nlen + ndist) {
+			return -EBADMSG;
+		}
+		memset(lengths + index, len, repeat);
+		index += repeat;
+	}
+
+	/* The end of block code is required */
+	if (lengths[256] == 0) {
+		return -EBADMSG;
+	}
+
+	ret = huffman_build(&inflate->lit, lengths, nlen);
+	if (ret) {
+		return ret;
+	}
+
+	ret = huffman_build(&inflate->dist, lengths + nlen, ndist);
+	if (ret) {
+		return ret;
+	}
+
+	return inflate_codes(inflate);
+}
+
+int esphome_ota_inflate(struct esphome_ota_inflate *inflate)
+{
+	int last;
+	int type;
+	int ret;
+
+	inflate->bits = 0;
+	inflate->bit_count = 0;
+	inflate->total = 0;
+	inflate->window_pos = 0;
+
+	do {
+		last = inflate_bits(inflate, 1);
+		if (last < 0) {
+			return last;
+		}
+
+		type = inflate_bits(inflate, 2);
+		switch (type) {
+		case 0:
+			ret = inflate_stored(inflate);
+			break;
+		case 1:
+			ret = inflate_fixed(inflate);
+			break;
+		case 2:
+			ret = inflate_dynamic(inflate);
+			break;
+		default:
+			ret = type < 0 ? type : -EBADMSG;
+			break;
+		}
+		if (ret) {
+			return ret;
+		}
+	} while (!last);
+
+	if (inflate->window_pos) {
+		return inflate->write(inflate, inflate->window, inflate->window_pos);
+	}
+
+	return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ESPHOME_OTA_INFLATE_H
+#define ESPHOME_OTA_INFLATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/util.h>
+
+#define ESPHOME_OTA_INFLATE_WINDOW_SIZE BIT(CONFIG_ESPHOME_OTA_DEFLATE_WINDOW_BITS)
+
+/* Canonical Huffman code */
+struct esphome_ota_huffman {
+	/* Number of codes of each length */
+	uint16_t counts[16];
+	/* Symbols, ordered by code */
+	uint16_t symbols[288];
+};
+
+/*
+ * Raw deflate (RFC 1951) decoder, pulling its input a byte at a time, whose
+ * back references can't go further than the window. The output goes through
+ * the window, which is written each time it is full.
+ */
+struct esphome_ota_inflate {
+	/* Returns the next input byte, or a negative error code */
+	int (*read_byte)(struct esphome_ota_inflate *inflate);
+	int (*write)(struct esphome_ota_inflate *inflate, const uint8_t *data, size_t len);
+
+	uint32_t bits;
+	uint8_t bit_count;
+	/* Size of the output */
+	size_t total;
+	size_t window_pos;
+	uint8_t window[ESPHOME_OTA_INFLATE_WINDOW_SIZE];
+	struct esphome_ota_huffman lit;
+	struct esphome_ota_huffman dist;
+	uint8_t lengths[286 + 30];
+};
+
+/* Decodes the stream up to its final block, and writes the end of the output */
+int esphome_ota_inflate(struct esphome_ota_inflate *inflate);
+
+#endif /* ESPHOME_OTA_INFLATE_H */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT nabucasa_esphome_sensor_api_stats
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+
+#include <esphome/components/api.h>
+#include <esphome/components/sensor.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(ESPHome, CONFIG_ESPHOME_LOG_LEVEL);
+
+/* Same order as the statistic enum of the binding */
+enum esphome_api_stat {
+	ESPHOME_API_STAT_RX_FRAMES,
+	ESPHOME_API_STAT_RX_BYTES,
+	ESPHOME_API_STAT_TX_FRAMES,
+	ESPHOME_API_STAT_TX_BYTES,
+	ESPHOME_API_STAT_DROPPED,
+	ESPHOME_API_STAT_DECODE_ERRORS,
+	ESPHOME_API_STAT_ALLOC_FAILURES,
+	ESPHOME_API_STAT_HANDLE_TIME,
+};
+
+struct esphome_api_stats_sensor_config {
+	const struct device *api_dev;
+	enum esphome_api_stat stat;
+};
+
+int device_read_api_stats(const struct device *dev, float *state)
+{
+	const struct esphome_api_stats_sensor_config *config = dev->config;
+	struct esphome_rpc_totals totals;
+
+	esphome_rpc_stats_get_totals(config->api_dev, &totals);
+
+	switch (config->stat) {
+	case ESPHOME_API_STAT_RX_FRAMES:
+		*state = totals.counters.rx_frames;
+		break;
+	case ESPHOME_API_STAT_RX_BYTES:
+		*state = totals.counters.rx_bytes;
+		break;
+	case ESPHOME_API_STAT_TX_FRAMES:
+		*state = totals.counters.tx_frames;
+		break;
+	case ESPHOME_API_STAT_TX_BYTES:
+		*state = totals.counters.tx_bytes;
+		break;
+	case ESPHOME_API_STAT_DROPPED:
+		*state = totals.counters.tx_dropped;
+		break;
+	case ESPHOME_API_STAT_DECODE_ERRORS:
+		*state = totals.decode_errors;
+		break;
+	case ESPHOME_API_STAT_ALLOC_FAILURES:
+		*state = totals.alloc_failures;
+		break;
+	case ESPHOME_API_STAT_HANDLE_TIME:
+		*state = (float)totals.handle_time / USEC_PER_MSEC;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+struct esphome_sensor_api esphome_api_stats_sensor = {
+	.read = device_read_api_stats,
+};
+
+#define DEFINE_ESPHOME_SENSOR_API_STATS(_num)                                                      \
+                                                                                                   \
+	static struct esphome_sensor_data esphome_sensor_data_##_num;                              \
+                                                                                                   \
+	static const struct esphome_api_stats_sensor_config esphome_api_stats_config_##_num = {    \
+		.api_dev = DEVICE_DT_GET_ONE(nabucasa_esphome_api),                                \
+		.stat = DT_INST_ENUM_IDX(_num, statistic),                                         \
+	};                                                                                         \
+                                                                                                   \
+	DEVICE_DT_INST_DEFINE(_num, esphome_sensor_init, NULL, &esphome_sensor_data_##_num,        \
+			      &esphome_api_stats_config_##_num, POST_KERNEL,                       \
+			      CONFIG_ESPHOME_INIT_PRIORITY, &esphome_api_stats_sensor);            \
+	DEFINE_ESPHOME_SENSOR_ENTITY(_num, esphome_api_stats_sensor_##_num);
+
+DT_INST_FOREACH_STATUS_OKAY(DEFINE_ESPHOME_SENSOR_API_STATS);
@@ -49,22 +49,24 @@ void sensor_humidity_handler(const struct device *dev, const struct sensor_trigg
 
 	ARG_UNUSED(dev);
 
-	data->data_rdy = 1;
+	esphome_sensor_data_ready(data);
 }
 
 int device_init_humidity(const struct device *dev)
 {
 	const struct esphome_humidity_sensor_config *config = dev->config;
 	struct esphome_sensor_data *data = dev->data;
+	int ret;
 
 	if (!device_is_ready(config->sensor)) {
 		return -ENODEV;
 	}
 
-	/* TODO: use the delta trigger with configurable threshold */
 	data->trig.type = SENSOR_TRIG_DATA_READY;
 	data->trig.chan = SENSOR_CHAN_HUMIDITY;
-	sensor_trigger_set(config->sensor, &data->trig, sensor_humidity_handler);
+	/* Sensors without trigger support are polled */
+	ret = sensor_trigger_set(config->sensor, &data->trig, sensor_humidity_handler);
+	data->triggered = !ret;
 
 	return 0;
 }
@@ -4,26 +4,103 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/init.h>
+
 #include <esphome/components/api.h>
 #include <esphome/components/entity.h>
 #include <esphome/components/sensor.h>
+#include <esphome/workq.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(ESPHome, CONFIG_ESPHOME_LOG_LEVEL);
 
-static int esphome_sensor_service(void *arg1, void *arg2, void *arg3)
+/* A triggered sensor is never read again right away, it would hog the work queue */
+#define ESPHOME_SENSOR_MIN_DELAY_MS 100
+
+static bool esphome_sensor_should_publish(struct esphome_sensor_data *data,
+					  const struct esphome_sensor_config *config, float state,
+					  int64_t now)
+{
+	float diff = state - data->state;
+
+	if (!data->has_state) {
+		return true;
+	}
+
+	if (config->heartbeat && now - data->published_at >= config->heartbeat) {
+		return true;
+	}
+
+	if (!config->delta) {
+		return state != data->state;
+	}
+
+	return (diff < 0 ? -diff : diff) * 1000.0f >= config->delta;
+}
+
+static void esphome_sensor_update(struct k_work *work)
 {
-	while (1) {
-		STRUCT_SECTION_FOREACH(esphome_sensor_entity, sensor) {
-			const struct esphome_entity *entity = sensor->entity;
-			esphome_sensor_send_state(entity->data->api_dev, entity);
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct esphome_sensor_data *data = CONTAINER_OF(dwork, struct esphome_sensor_data, work);
+	const struct esphome_entity *entity = data->entity;
+	const struct esphome_sensor_config *config = entity->private_config;
+	int64_t now = k_uptime_get();
+	float state;
+	int ret;
+
+	ret = esphome_sensor_read(entity->dev, &state);
+	if (ret) {
+		LOG_WRN("Failed to read %s [%d]", entity->config->name, ret);
+	} else if (esphome_sensor_should_publish(data, config, state, now)) {
+		union esphome_entity_state value = {.raw = 0};
+		/* The heartbeat is sent even to clients that already have the value */
+		bool force = data->has_state && config->heartbeat &&
+			     now - data->published_at >= config->heartbeat;
+
+		value.value = state;
+		esphome_entity_publish(entity, value, force);
+		data->state = state;
+		data->published_at = now;
+		data->has_state = true;
+	}
+
+	if (!data->triggered) {
+		k_work_schedule_for_queue(&esphome_background_workq, dwork,
+					  K_MSEC(config->update_interval));
+	} else if (config->heartbeat && data->has_state) {
+		/* A failed read is retried at the polling pace, its heartbeat has expired */
+		int64_t delay = ret ? config->update_interval
+				    : config->heartbeat - (now - data->published_at);
+
+		k_work_schedule_for_queue(&esphome_background_workq, dwork,
+					  K_MSEC(MAX(delay, ESPHOME_SENSOR_MIN_DELAY_MS)));
+	}
+}
+
+void esphome_sensor_data_ready(struct esphome_sensor_data *data)
+{
+	/* Triggers may fire before the sensor entities are initialized */
+	if (data->entity) {
+		k_work_reschedule_for_queue(&esphome_background_workq, &data->work, K_NO_WAIT);
+	}
+}
+
+static int esphome_sensor_service_init(void)
+{
+	STRUCT_SECTION_FOREACH(esphome_sensor_entity, sensor) {
+		const struct esphome_entity *entity = sensor->entity;
+		struct esphome_sensor_data *data = entity->dev->data;
+
+		if (!device_is_ready(entity->dev)) {
+			continue;
 		}
-		k_sleep(K_MSEC(1000));
+
+		k_work_init_delayable(&data->work, esphome_sensor_update);
+		data->entity = entity;
+		k_work_schedule_for_queue(&esphome_background_workq, &data->work, K_NO_WAIT);
 	}
 
 	return 0;
 }
 
-#define ESPHOME_SENSOR_STACK_SIZE 2048
-K_THREAD_DEFINE(esphome_sensor_tid, ESPHOME_SENSOR_STACK_SIZE, esphome_sensor_service, NULL, NULL,
-		NULL, 0, 0, 0);
+SYS_INIT(esphome_sensor_service_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/shell/shell.h>
+
+/* The components add their commands with SHELL_SUBCMD_ADD((esphome), ...) */
+SHELL_SUBCMD_SET_CREATE(sub_esphome, (esphome));
+
+SHELL_CMD_REGISTER(esphome, &sub_esphome, "ESPHome commands", NULL);
@@ -58,6 +58,21 @@ static int esphome_gpio_switch_set_state(const struct device *dev, int state)
 	return 0;
 }
 
+static int esphome_gpio_switch_stage_state(const struct device *dev, int state,
+					   struct esphome_switch_batch *batch)
+{
+	const struct esphome_gpio_switch_config *config = dev->config;
+
+	return esphome_switch_batch_set_pin(batch, &config->gpio, state);
+}
+
+static void esphome_gpio_switch_state_applied(const struct device *dev, int state)
+{
+	struct esphome_gpio_switch_data *data = dev->data;
+
+	data->state = state;
+}
+
 static int esphome_gpio_switch_get_state(const struct device *dev)
 {
 	struct esphome_gpio_switch_data *data = dev->data;
@@ -68,6 +83,8 @@ static int esphome_gpio_switch_get_state(const struct device *dev)
 static struct esphome_switch_component_api gpio_switch = {
 	.set_state = esphome_gpio_switch_set_state,
 	.get_state = esphome_gpio_switch_get_state,
+	.stage_state = esphome_gpio_switch_stage_state,
+	.state_applied = esphome_gpio_switch_state_applied,
 };
 
 #define DEFINE_ESPHOME_SWITCH_GPIO(_num)                                                           \
@@ -81,7 +98,6 @@ static struct esphome_switch_component_api gpio_switch = {
 			      &esphome_gpio_switch_data_##_num,                                    \
 			      &esphome_gpio_switch_config_##_num, POST_KERNEL,                     \
 			      CONFIG_ESPHOME_INIT_PRIORITY, &gpio_switch);                         \
-	DEFINE_ESPHOME_ENTITY(_num, esphome_gpio_switch_##_num, "switch.gpio",                     \
-			      esphome_switch_list_entity);
+	DEFINE_ESPHOME_SWITCH_ENTITY(_num, esphome_gpio_switch_##_num, "switch.gpio");
 
 DT_INST_FOREACH_STATUS_OKAY(DEFINE_ESPHOME_SWITCH_GPIO);
@@ -14,20 +14,105 @@
 #include <esphome/components/api.h>
 #include <esphome/components/entity.h>
 #include <esphome/components/switch.h>
+#include <esphome/workq.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(ESPHome, CONFIG_ESPHOME_LOG_LEVEL);
 
+/*
+ * A pulse drives one of the pins for wait_time ms, to latch the relay in a
+ * state. The pulse is ended by the actuation work queue, so the caller
+ * doesn't wait for it and the pulses of different bridges overlap.
+ */
+
 struct esphome_switch_hbridge_config {
 	const struct gpio_dt_spec on_pin;
 	const struct gpio_dt_spec off_pin;
 	int wait_time;
+#ifdef CONFIG_ESPHOME_COMPONENT_API
+	uint32_t key;
+#endif
 };
 
 struct esphome_switch_hbridge_data {
+	const struct device *dev;
+	/* Serializes the pin changes, which may sleep */
+	struct k_mutex lock;
+	/* Ends the pulse */
+	struct k_work_delayable work;
+	/* State latched by the last completed pulse */
 	int state;
+	/* State latched by the pulse in progress */
+	int pulse_state;
 };
 
+static int esphome_switch_hbridge_gpios(const struct device *dev, int on_pin, int off_pin)
+{
+	const struct esphome_switch_hbridge_config *config = dev->config;
+	int ret;
+
+	/* The pin going low first, so that both pins are never high */
+	if (!on_pin) {
+		ret = gpio_pin_set_dt(&config->on_pin, 0);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	ret = gpio_pin_set_dt(&config->off_pin, off_pin);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (on_pin) {
+		ret = gpio_pin_set_dt(&config->on_pin, 1);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void esphome_switch_hbridge_publish(const struct device *dev)
+{
+#ifdef CONFIG_ESPHOME_COMPONENT_API
+	const struct esphome_switch_hbridge_config *config = dev->config;
+	const struct esphome_entity *entity = find_entity_by_key(config->key);
+
+	if (entity) {
+		esphome_switch_publish_state(entity);
+	}
+#endif
+}
+
+static void esphome_switch_hbridge_pulse_end(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct esphome_switch_hbridge_data *data =
+		CONTAINER_OF(dwork, struct esphome_switch_hbridge_data, work);
+	const struct device *dev = data->dev;
+	int ret;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	/* Another pulse started while this one was ending, it will end it */
+	if (k_work_delayable_busy_get(dwork) & (K_WORK_DELAYED | K_WORK_QUEUED)) {
+		k_mutex_unlock(&data->lock);
+		return;
+	}
+
+	ret = esphome_switch_hbridge_gpios(dev, 0, 0);
+	if (ret < 0) {
+		LOG_ERR("Failed to set hbridge state");
+		data->state = ret;
+	} else {
+		data->state = data->pulse_state;
+	}
+	k_mutex_unlock(&data->lock);
+
+	esphome_switch_hbridge_publish(dev);
+}
+
 static int esphome_switch_hbridge_init(const struct device *dev)
 {
 	const struct esphome_switch_hbridge_config *config = dev->config;
@@ -44,52 +129,73 @@ static int esphome_switch_hbridge_init(const struct device *dev)
 		return ret;
 	}
 
+	data->dev = dev;
 	data->state = -EINVAL;
+	k_mutex_init(&data->lock);
+	k_work_init_delayable(&data->work, esphome_switch_hbridge_pulse_end);
 
 	return 0;
 }
 
-static int esphome_switch_hbridge_gpios(const struct device *dev, int on_pin, int off_pin)
+/* Start the pulse, the state is updated and published once it ends */
+static int esphome_switch_hbridge_set_state(const struct device *dev, int state)
 {
 	const struct esphome_switch_hbridge_config *config = dev->config;
+	struct esphome_switch_hbridge_data *data = dev->data;
 	int ret;
 
-	ret = gpio_pin_set_dt(&config->on_pin, on_pin);
+	k_mutex_lock(&data->lock, K_FOREVER);
+	ret = esphome_switch_hbridge_gpios(dev, state, !state);
 	if (ret < 0) {
+		LOG_ERR("Failed to set hbridge state");
+		(void)esphome_switch_hbridge_gpios(dev, 0, 0);
+		k_mutex_unlock(&data->lock);
 		return ret;
 	}
 
-	ret = gpio_pin_set_dt(&config->off_pin, off_pin);
-	if (ret < 0) {
-		return ret;
-	}
+	/* A pulse in progress is cut short by this one */
+	data->pulse_state = state;
+	k_work_reschedule_for_queue(&esphome_actuation_workq, &data->work,
+				    K_MSEC(config->wait_time));
+	k_mutex_unlock(&data->lock);
 
 	return 0;
 }
 
-static int esphome_switch_hbridge_set_state(const struct device *dev, int state)
+static int esphome_switch_hbridge_stage_state(const struct device *dev, int state,
+					      struct esphome_switch_batch *batch)
 {
 	const struct esphome_switch_hbridge_config *config = dev->config;
 	struct esphome_switch_hbridge_data *data = dev->data;
+	struct k_work_sync sync;
 	int ret;
 
-	ret = esphome_switch_hbridge_gpios(dev, state, !state);
-	if (ret < 0) {
-		LOG_ERR("Failed to set hbridge state");
-		return ret;
+	/* Both pins must be written at once, so that they are never high together */
+	if (config->on_pin.port != config->off_pin.port) {
+		return -ENOTSUP;
 	}
 
-	k_sleep(K_MSEC(config->wait_time));
+	/* The pulse in progress must not end the one starting */
+	k_work_cancel_delayable_sync(&data->work, &sync);
 
-	ret = esphome_switch_hbridge_gpios(dev, 0, 0);
-	if (ret < 0) {
-		LOG_ERR("Failed to set hbridge state");
+	ret = esphome_switch_batch_set_pin(batch, &config->on_pin, state);
+	if (ret) {
 		return ret;
 	}
 
-	data->state = state;
+	return esphome_switch_batch_set_pin(batch, &config->off_pin, !state);
+}
 
-	return 0;
+static void esphome_switch_hbridge_state_applied(const struct device *dev, int state)
+{
+	const struct esphome_switch_hbridge_config *config = dev->config;
+	struct esphome_switch_hbridge_data *data = dev->data;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	data->pulse_state = state;
+	k_work_reschedule_for_queue(&esphome_actuation_workq, &data->work,
+				    K_MSEC(config->wait_time));
+	k_mutex_unlock(&data->lock);
 }
 
 static int esphome_switch_hbridge_get_state(const struct device *dev)
@@ -102,6 +208,8 @@ static int esphome_switch_hbridge_get_state(const struct device *dev)
 static struct esphome_switch_component_api hbridge_switch = {
 	.set_state = esphome_switch_hbridge_set_state,
 	.get_state = esphome_switch_hbridge_get_state,
+	.stage_state = esphome_switch_hbridge_stage_state,
+	.state_applied = esphome_switch_hbridge_state_applied,
 };
 
 #define DEFINE_ESPHOME_SWITCH_HBRIDGE(_num)                                                        \
@@ -110,6 +218,8 @@ static struct esphome_switch_component_api hbridge_switch = {
 		.on_pin = GPIO_DT_SPEC_GET(DT_DRV_INST(_num), on_gpios),                           \
 		.off_pin = GPIO_DT_SPEC_GET(DT_DRV_INST(_num), off_gpios),                         \
 		.wait_time = DT_INST_PROP(_num, wait_time),                                        \
+		IF_ENABLED(CONFIG_ESPHOME_COMPONENT_API,                                           \
+			   (.key = DT_ESPHOME_ENTITY_KEY(_num),))                                  \
 	};                                                                                         \
 	static struct esphome_switch_hbridge_data esphome_switch_hbridge_data_##_num;              \
                                                                                                    \
@@ -117,7 +227,6 @@ static struct esphome_switch_component_api hbridge_switch = {
 			      &esphome_switch_hbridge_data_##_num,                                 \
 			      &esphome_switch_hbridge_config_##_num, POST_KERNEL,                  \
 			      CONFIG_ESPHOME_INIT_PRIORITY, &hbridge_switch);                      \
-	DEFINE_ESPHOME_ENTITY(_num, esphome_switch_hbridge_##_num, "switch.hbridge",               \
-			      esphome_switch_list_entity);
+	DEFINE_ESPHOME_SWITCH_ENTITY(_num, esphome_switch_hbridge_##_num, "switch.hbridge");
 
 DT_INST_FOREACH_STATUS_OKAY(DEFINE_ESPHOME_SWITCH_HBRIDGE);
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/drivers/gpio.h>
+
+#include <esphome/components/switch.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ESPHomeSwitch, CONFIG_ESPHOME_LOG_LEVEL);
+
+void esphome_switch_batch_init(struct esphome_switch_batch *batch)
+{
+	batch->port_count = 0;
+	batch->switch_count = 0;
+}
+
+int esphome_switch_batch_set_pin(struct esphome_switch_batch *batch,
+				 const struct gpio_dt_spec *spec, int value)
+{
+	struct esphome_switch_batch_port *port = NULL;
+	gpio_port_pins_t pin = BIT(spec->pin);
+	size_t index;
+
+	for (index = 0; index < batch->port_count; index++) {
+		if (batch->ports[index].port == spec->port) {
+			port = &batch->ports[index];
+			break;
+		}
+	}
+
+	if (!port) {
+		if (batch->port_count == ARRAY_SIZE(batch->ports)) {
+			return -ENOSPC;
+		}
+
+		port = &batch->ports[batch->port_count++];
+		port->port = spec->port;
+		port->mask = 0;
+		port->value = 0;
+	}
+	batch->staged_ports |= BIT(index);
+
+	/* The port is written raw, as gpio_pin_set_dt() would */
+	if (spec->dt_flags & GPIO_ACTIVE_LOW) {
+		value = !value;
+	}
+
+	port->mask |= pin;
+	if (value) {
+		port->value |= pin;
+	} else {
+		port->value &= ~pin;
+	}
+
+	return 0;
+}
+
+static int esphome_switch_batch_stage(struct esphome_switch_batch *batch, const struct device *dev,
+				      const struct esphome_entity *entity, int state)
+{
+	const struct esphome_switch_component_api *api = dev->api;
+	struct esphome_switch_batch_port ports[ARRAY_SIZE(batch->ports)];
+	size_t port_count = batch->port_count;
+	struct esphome_switch_batch_entry *entry = NULL;
+	int ret;
+
+	if (!api->stage_state) {
+		return -ENOTSUP;
+	}
+
+	/* A switch staged again takes its last state */
+	for (size_t i = 0; i < batch->switch_count; i++) {
+		if (batch->switches[i].dev == dev) {
+			entry = &batch->switches[i];
+			break;
+		}
+	}
+
+	if (!entry && batch->switch_count == ARRAY_SIZE(batch->switches)) {
+		return -ENOSPC;
+	}
+
+	/* The switches using several pins are staged completely or not at all */
+	memcpy(ports, batch->ports, sizeof(ports));
+	batch->staged_ports = 0;
+	ret = api->stage_state(dev, state, batch);
+	if (ret) {
+		memcpy(batch->ports, ports, sizeof(ports));
+		batch->port_count = port_count;
+		return ret;
+	}
+
+	if (!entry) {
+		entry = &batch->switches[batch->switch_count++];
+		entry->dev = dev;
+	}
+	entry->entity = entity;
+	entry->state = state;
+	entry->ports = batch->staged_ports;
+
+	return 0;
+}
+
+int esphome_switch_batch_add(struct esphome_switch_batch *batch, const struct device *dev,
+			     int state)
+{
+	return esphome_switch_batch_stage(batch, dev, NULL, state);
+}
+
+int esphome_switch_batch_add_entity(struct esphome_switch_batch *batch,
+				    const struct esphome_entity *entity, int state)
+{
+	return esphome_switch_batch_stage(batch, entity->dev, entity, state);
+}
+
+int esphome_switch_batch_apply(struct esphome_switch_batch *batch)
+{
+	uint32_t failed_ports = 0;
+	int err = 0;
+	int ret;
+
+	for (size_t i = 0; i < batch->port_count; i++) {
+		struct esphome_switch_batch_port *port = &batch->ports[i];
+
+		ret = gpio_port_set_masked_raw(port->port, port->mask, port->value);
+		if (ret < 0) {
+			LOG_ERR("Failed to set the pins of %s", port->port->name);
+			failed_ports |= BIT(i);
+			err = ret;
+		}
+	}
+
+	for (size_t i = 0; i < batch->switch_count; i++) {
+		struct esphome_switch_batch_entry *entry = &batch->switches[i];
+		const struct esphome_switch_component_api *api = entry->dev->api;
+
+		/* Its pins may not have changed, its state is left as it was */
+		if (entry->ports & failed_ports) {
+			LOG_ERR("Failed to switch %s", entry->dev->name);
+			continue;
+		}
+
+		if (api->state_applied) {
+			api->state_applied(entry->dev, entry->state);
+		}
+	}
+
+	return err;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+
+#include <esphome/workq.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ESPHomeWorkq, CONFIG_ESPHOME_LOG_LEVEL);
+
+#ifdef CONFIG_ESPHOME_ACTUATION_WORKQ
+static K_THREAD_STACK_DEFINE(esphome_actuation_stack, CONFIG_ESPHOME_ACTUATION_WORKQ_STACK_SIZE);
+struct k_work_q esphome_actuation_workq;
+#endif
+
+static K_THREAD_STACK_DEFINE(esphome_background_stack, CONFIG_ESPHOME_BACKGROUND_WORKQ_STACK_SIZE);
+struct k_work_q esphome_background_workq;
+
+/* Started before the components can submit work, from SYS_INIT or devices */
+static int esphome_workq_init(void)
+{
+#ifdef CONFIG_ESPHOME_ACTUATION_WORKQ
+	const struct k_work_queue_config actuation_config = {
+		.name = "esphome_actuation",
+	};
+
+	k_work_queue_start(&esphome_actuation_workq, esphome_actuation_stack,
+			   K_THREAD_STACK_SIZEOF(esphome_actuation_stack),
+			   CONFIG_ESPHOME_ACTUATION_WORKQ_PRIORITY, &actuation_config);
+#endif
+	const struct k_work_queue_config background_config = {
+		.name = "esphome_background",
+	};
+
+	k_work_queue_start(&esphome_background_workq, esphome_background_stack,
+			   K_THREAD_STACK_SIZEOF(esphome_background_stack),
+			   CONFIG_ESPHOME_BACKGROUND_WORKQ_PRIORITY, &background_config);
+
+	return 0;
+}
+
+SYS_INIT(esphome_workq_init, POST_KERNEL, 0);
+
+#ifdef CONFIG_ESPHOME_NET
+
+STRUCT_SECTION_START_EXTERN(esphome_net_pollfd);
+
+static void esphome_net_init(void)
+{
+	STRUCT_SECTION_FOREACH(esphome_net_service, service) {
+		int ret = service->init(service->data);
+
+		service->ready = !ret;
+		if (ret) {
+			LOG_ERR("Failed to start %s (%d)", service->name, ret);
+		}
+	}
+}
+
+/* Returns the poll timeout in ms, -1 if none */
+static int esphome_net_prepare(void)
+{
+	int timeout = -1;
+
+	STRUCT_SECTION_FOREACH(esphome_net_service, service) {
+		int service_timeout;
+
+		if (!service->ready) {
+			for (size_t i = 0; i < service->nfds; i++) {
+				service->fds[i].fd = -1;
+			}
+			continue;
+		}
+
+		service_timeout = service->prepare(service->data, service->fds);
+		if (service_timeout >= 0 && (timeout < 0 || service_timeout < timeout)) {
+			timeout = service_timeout;
+		}
+	}
+
+	return timeout;
+}
+
+/*
+ * The single thread waiting on the sockets: the pollfds of the services are
+ * in one linker section, so they are all polled at once.
+ */
+static void esphome_net_service_run(void *arg1, void *arg2, void *arg3)
+{
+	struct zsock_pollfd *fds = &STRUCT_SECTION_START(esphome_net_pollfd)->fd;
+	int nfds;
+	int ret;
+
+	STRUCT_SECTION_COUNT(esphome_net_pollfd, &nfds);
+	esphome_net_init();
+
+	while (1) {
+		ret = zsock_poll(fds, nfds, esphome_net_prepare());
+		if (ret < 0) {
+			LOG_ERR("poll() failed (%d)", errno);
+			continue;
+		}
+
+		STRUCT_SECTION_FOREACH(esphome_net_service, service) {
+			if (service->ready) {
+				service->handle(service->data, service->fds);
+			}
+		}
+	}
+}
+
+K_THREAD_DEFINE(esphome_net_tid, CONFIG_ESPHOME_NET_STACK_SIZE, esphome_net_service_run, NULL,
+		NULL, NULL, CONFIG_ESPHOME_NET_PRIORITY, 0, 0);
+
+#endif /* CONFIG_ESPHOME_NET */
@@ -30,14 +30,11 @@ static inline int esphome_button_list_entity(const struct device *api_dev,
 					     struct esphome_entity *entity)
 {
 	const struct esphome_entity_config *config = entity->config;
-	struct esphome_entity_data *data = entity->data;
 	ListEntitiesButtonResponse response = LIST_ENTITIES_BUTTON_RESPONSE__INIT;
 
 	DT_ENTITY_CONFIG_TO_RESPONSE(&response, config);
-	response.key = data->key;
-	ListEntitiesButtonResponseWrite(api_dev, &response);
-
-	return 0;
+	response.key = entity->key;
+	return ListEntitiesButtonResponseWrite(api_dev, &response);
 }
 #endif /* CONFIG_ESPHOME_COMPONENT_API */
 
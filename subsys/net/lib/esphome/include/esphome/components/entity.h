@@ -14,6 +14,8 @@
 #include <zephyr/toolchain.h>
 #include <esphome/components/api.h>
 
+#include <esphome_entity_keys.h>
+
 #ifndef CONFIG_PROTOBUF_C
 #define DT_ENTITY_STRCPY_SAFE(_resp, _cfg, _name)                                                  \
 	_string_copy_safe((_resp)->_name, (_cfg)->_name, ARRAY_SIZE((_resp)->_name))
@@ -41,9 +43,26 @@
 		.object_id = STRINGIFY(DT_STRING_TOKEN(DT_DRV_INST(_num), device_name)),            \
 				       .unique_id = DT_ESPHOME_UNIQUE_NAME(_num, _device_class),   \
 				       .icon = NULL, .disabled_by_default = 0,                     \
-				       .entity_category = 0, .device_class = _device_class,        \
+		.entity_category = DT_INST_ENUM_IDX_OR(_num, entity_category, 0),                  \
+		.device_class = _device_class,                                                     \
+		.on_value = DT_ESPHOME_ENTITY_ON_VALUE(_num),                                      \
 		}
 
+#define DT_ESPHOME_ENTITY_ON_VALUE(_num)                                                           \
+	COND_CODE_1(DT_INST_NODE_HAS_PROP(_num, on_value),                                         \
+		    (DT_STRING_UNQUOTED(DT_DRV_INST(_num), on_value)), (NULL))
+
+#define DT_ESPHOME_ENTITY_DECLARE_ON_VALUE(_num)                                                   \
+	IF_ENABLED(DT_INST_NODE_HAS_PROP(_num, on_value),                                          \
+		   (extern void DT_STRING_UNQUOTED(DT_DRV_INST(_num), on_value)(                   \
+			   const struct device *dev);))
+
+/* Keys are computed at build time by scripts/esphome/gen_entity_keys.py */
+#define DT_ESPHOME_ENTITY_KEY(_num)                                                                \
+	UTIL_CAT(ESPHOME_ENTITY_KEY_, DT_STRING_TOKEN(DT_DRV_INST(_num), device_name))
+#define DT_ESPHOME_ENTITY_KEY_NAME(_num)                                                           \
+	UTIL_CAT(ESPHOME_ENTITY_KEY_NAME_, DT_STRING_TOKEN(DT_DRV_INST(_num), device_name))
+
 #define ESPHOME_UNIT_PERCENT "%"
 #define ESPHOME_UNIT_CELSUIS "°C"
 #define ESPHOME_UNIT_FAHRENHEIT "°F"
@@ -56,34 +75,65 @@ struct esphome_entity_config {
 	bool disabled_by_default;
 	EntityCategory entity_category;
 	const char *device_class;
+	/* Called each time a state is published, may be NULL */
+	void (*on_value)(const struct device *dev);
+};
+
+/* Entity state, compared as raw bits to detect changes */
+union esphome_entity_state {
+	uint32_t raw;
+	float value;
+	bool on;
 };
 
 struct esphome_entity_data {
-	uint32_t key;
 	/* Find a way to get it using DT */
 	const struct device *api_dev;
+	const struct esphome_entity *entity;
+	/* Last known state, written by the publisher and read by the API thread */
+	union esphome_entity_state state;
+	bool has_state;
+	/* Set when the next state must be sent even if unchanged */
+	atomic_t force;
+	/* Posted to the API thread when the state is published */
+	struct esphome_rpc_event event;
+	/* Last state sent to each connection, valid if its bit is set in sent_mask */
+	union esphome_entity_state sent[CONFIG_ESPHOME_RPC_MAX_CONNECTIONS];
+	uint8_t sent_mask;
 };
 
 struct esphome_entity {
+	uint32_t key;
 	const struct device *dev;
 	const struct esphome_entity_config *config;
 	const void *private_config;
 	struct esphome_entity_data *data;
 	int (*list_entity)(const struct device *api_dev, struct esphome_entity *entity);
+	/* Send a state of the entity, NULL for entities without a state */
+	int (*send_state)(const struct device *api_dev, const struct esphome_entity *entity,
+			  union esphome_entity_state state);
 };
 
-#define DEFINE_ESPHOME_ENTITY_WITH_CONF(_num, name, _device_class, _list_entity, _priv_conf)       \
+#define DEFINE_ESPHOME_ENTITY_WITH_STATE(_num, name, _device_class, _list_entity, _send_state,    \
+					 _priv_conf)                                               \
+	DT_ESPHOME_ENTITY_DECLARE_ON_VALUE(_num)                                                   \
 	static struct esphome_entity_config name##_entity_config =                                 \
 		DT_ESPHOME_ENTITY(_num, _device_class);                                            \
 	static struct esphome_entity_data name##_entity_data;                                      \
-	STRUCT_SECTION_ITERABLE(esphome_entity, name) = {                                          \
+	/* Sorted by key */                                                                        \
+	STRUCT_SECTION_ITERABLE_NAMED(esphome_entity, DT_ESPHOME_ENTITY_KEY_NAME(_num), name) = {  \
+		.key = DT_ESPHOME_ENTITY_KEY(_num),                                                \
 		.dev = DEVICE_DT_GET(DT_DRV_INST(_num)),                                           \
 		.config = &name##_entity_config,                                                   \
 		.private_config = _priv_conf,                                                      \
 		.data = &name##_entity_data,                                                       \
 		.list_entity = _list_entity,                                                       \
+		.send_state = _send_state,                                                         \
 	}
 
+#define DEFINE_ESPHOME_ENTITY_WITH_CONF(_num, name, _device_class, _list_entity, _priv_conf)       \
+	DEFINE_ESPHOME_ENTITY_WITH_STATE(_num, name, _device_class, _list_entity, NULL, _priv_conf)
+
 #define DEFINE_ESPHOME_ENTITY(_num, name, _device_class, _list_entity)                             \
 	DEFINE_ESPHOME_ENTITY_WITH_CONF(_num, name, _device_class, _list_entity, NULL)
 
@@ -92,12 +142,18 @@ struct esphome_entity {
 int _string_copy_safe(char *dest, const char *src, size_t len);
 #define strcpy_safe(_dest, _src) _string_copy_safe(_dest, _src, ARRAY_SIZE(_dest))
 
-uint32_t fnv1_hash(const char *str);
+const struct esphome_entity *find_entity_by_key(uint32_t key);
 const struct device *find_device_entity_by_key(uint32_t key);
 int esphome_entity_init(const struct device *api_dev);
+int esphome_entity_publish(const struct esphome_entity *entity, union esphome_entity_state state,
+			   bool force);
+int esphome_entity_send_states(const struct device *api_dev);
+int esphome_entity_resend_states(const struct device *api_dev);
 char *esphome_build_unique_id(const char *base_name, char *buffer, int len);
 #else
 
+#define DEFINE_ESPHOME_ENTITY_WITH_STATE(_num, name, _device_class, _list_entity, _send_state,    \
+					 _priv_conf)
 #define DEFINE_ESPHOME_ENTITY(_num, name, _device_class, _list_entity)
 
 #endif /* CONFIG_ESPHOME_COMPONENT_API */
@@ -9,7 +9,16 @@
 
 struct esphome_sensor_data {
 	struct sensor_trigger trig;
-	bool data_rdy;
+	/* Set when the sensor notifies new samples, otherwise it is polled */
+	bool triggered;
+#ifdef CONFIG_ESPHOME_COMPONENT_API
+	const struct esphome_entity *entity;
+	struct k_work_delayable work;
+	/* Last published state */
+	float state;
+	int64_t published_at;
+	bool has_state;
+#endif
 };
 
 struct esphome_sensor_api {
@@ -35,6 +44,15 @@ static inline int esphome_sensor_read(const struct device *dev, float *state)
 	return api->read(dev, state);
 }
 
+#ifdef CONFIG_ESPHOME_COMPONENT_API
+void esphome_sensor_data_ready(struct esphome_sensor_data *data);
+#else
+static inline void esphome_sensor_data_ready(struct esphome_sensor_data *data)
+{
+	ARG_UNUSED(data);
+}
+#endif
+
 #ifdef CONFIG_ESPHOME_COMPONENT_API
 struct esphome_sensor_entity {
 	const struct esphome_entity *entity;
@@ -42,29 +60,36 @@ struct esphome_sensor_entity {
 
 struct esphome_sensor_config {
 	const char *unit_of_measurement;
+	/* In thousandths of the unit */
+	uint32_t delta;
+	/* In ms */
+	uint32_t heartbeat;
+	uint32_t update_interval;
 };
 
 #define DEFINE_ESPHOME_SENSOR_ENTITY(_num, name)                                                   \
 	static struct esphome_sensor_config esphome_sensor_config##_num = {                        \
 		.unit_of_measurement = DT_STRING_UPPER_TOKEN_OR(DT_DRV_INST(_num), unit, NULL),    \
+		.delta = DT_INST_PROP(_num, delta),                                                \
+		.heartbeat = DT_INST_PROP(_num, heartbeat),                                        \
+		.update_interval = DT_INST_PROP(_num, update_interval),                            \
 	};                                                                                         \
-	DEFINE_ESPHOME_ENTITY_WITH_CONF(_num, name, "sensor", esphome_sensor_list_entity,          \
-					&esphome_sensor_config##_num);                             \
+	DEFINE_ESPHOME_ENTITY_WITH_STATE(_num, name, "sensor", esphome_sensor_list_entity,         \
+					 esphome_sensor_send_state, &esphome_sensor_config##_num); \
 	STRUCT_SECTION_ITERABLE(esphome_sensor_entity, name##sensor_entity) = {                    \
 		.entity = &name,                                                                   \
 	}
 
-static inline void esphome_sensor_send_state(const struct device *api_dev,
-					     const struct esphome_entity *entity)
+static inline int esphome_sensor_send_state(const struct device *api_dev,
+					    const struct esphome_entity *entity,
+					    union esphome_entity_state state)
 {
-	struct esphome_entity_data *data = entity->data;
-	const struct device *dev = entity->dev;
 	SensorStateResponse response = SENSOR_STATE_RESPONSE__INIT;
 
-	/* TODO: Protect me */
-	response.key = data->key;
-	esphome_sensor_read(dev, &response.state);
-	SensorStateResponseWrite(api_dev, &response);
+	response.key = entity->key;
+	response.state = state.value;
+
+	return SensorStateResponseWrite(api_dev, &response);
 }
 
 static inline int esphome_sensor_list_entity(const struct device *api_dev,
@@ -72,16 +97,13 @@ static inline int esphome_sensor_list_entity(const struct device *api_dev,
 {
 	const struct esphome_entity_config *config = entity->config;
 	const struct esphome_sensor_config *sensor_config = entity->private_config;
-	struct esphome_entity_data *data = entity->data;
 	ListEntitiesSensorResponse response = LIST_ENTITIES_SENSOR_RESPONSE__INIT;
 
 	DT_ENTITY_CONFIG_TO_RESPONSE(&response, config);
 	DT_ENTITY_STRCPY_SAFE(&response, sensor_config, unit_of_measurement);
 	response.accuracy_decimals = 2;
-	response.key = data->key;
-	ListEntitiesSensorResponseWrite(api_dev, &response);
-
-	return 0;
+	response.key = entity->key;
+	return ListEntitiesSensorResponseWrite(api_dev, &response);
 }
 #else /* CONFIG_ESPHOME_COMPONENT_API */
 #define DEFINE_ESPHOME_SENSOR_ENTITY(_num, name)
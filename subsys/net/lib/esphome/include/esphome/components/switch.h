@@ -2,14 +2,67 @@
 #define ESPHOME_SWITCH_COMPONENT
 
 #include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
 
 #include <esphome/components/entity.h>
 
+/* Pins of one GPIO port changed by a batch */
+struct esphome_switch_batch_port {
+	const struct device *port;
+	gpio_port_pins_t mask;
+	gpio_port_value_t value;
+};
+
+struct esphome_switch_batch_entry {
+	const struct device *dev;
+	/* Set when added with esphome_switch_batch_add_entity() */
+	const struct esphome_entity *entity;
+	int state;
+	/* Bit of the index of each port holding its pins */
+	uint32_t ports;
+};
+
+/*
+ * Switch changes applied together: the pins of each GPIO port are written at
+ * once, so the switches of a port flip at the same instant.
+ */
+struct esphome_switch_batch {
+	struct esphome_switch_batch_port ports[CONFIG_ESPHOME_SWITCH_BATCH_PORTS];
+	size_t port_count;
+	struct esphome_switch_batch_entry switches[CONFIG_ESPHOME_SWITCH_BATCH_SIZE];
+	size_t switch_count;
+	/* Ports of the switch being staged */
+	uint32_t staged_ports;
+};
+
 struct esphome_switch_component_api {
 	int (*set_state)(const struct device *dev, int state);
 	int (*get_state)(const struct device *dev);
+	/*
+	 * Optional, for switches driving GPIOs: add the pins setting the state
+	 * to the batch, with esphome_switch_batch_set_pin(). state_applied is
+	 * called once the pins are written.
+	 */
+	int (*stage_state)(const struct device *dev, int state, struct esphome_switch_batch *batch);
+	void (*state_applied)(const struct device *dev, int state);
 };
 
+void esphome_switch_batch_init(struct esphome_switch_batch *batch);
+int esphome_switch_batch_set_pin(struct esphome_switch_batch *batch,
+				 const struct gpio_dt_spec *spec, int value);
+/* Returns -ENOTSUP if the switch can't be batched, -ENOSPC if the batch is full */
+int esphome_switch_batch_add(struct esphome_switch_batch *batch, const struct device *dev,
+			     int state);
+/* Same, keeping the entity of the switch in its entry, to publish its state */
+int esphome_switch_batch_add_entity(struct esphome_switch_batch *batch,
+				    const struct esphome_entity *entity, int state);
+/*
+ * Returns the error of the last port that couldn't be written, the switches
+ * with pins on such a port keep their state. The batch must be initialized
+ * again before being reused.
+ */
+int esphome_switch_batch_apply(struct esphome_switch_batch *batch);
+
 static inline int esphome_switch_get_state(const struct device *dev, int *state)
 {
 	const struct esphome_switch_component_api *api = dev->api;
@@ -60,16 +113,47 @@ static inline int esphome_switch_list_entity(const struct device *api_dev,
 					     struct esphome_entity *entity)
 {
 	const struct esphome_entity_config *config = entity->config;
-	struct esphome_entity_data *data = entity->data;
 	ListEntitiesSwitchResponse response = LIST_ENTITIES_SWITCH_RESPONSE__INIT;
 
 	DT_ENTITY_CONFIG_TO_RESPONSE(&response, config);
-	response.key = data->key;
+	response.key = entity->key;
 	//         response.assumed_state = config->entity.assumed_state;
-	ListEntitiesSwitchResponseWrite(api_dev, &response);
+	return ListEntitiesSwitchResponseWrite(api_dev, &response);
+}
+
+static inline int esphome_switch_send_state(const struct device *api_dev,
+					    const struct esphome_entity *entity,
+					    union esphome_entity_state state)
+{
+	SwitchStateResponse response = SWITCH_STATE_RESPONSE__INIT;
+
+	response.key = entity->key;
+	response.state = state.on;
 
-	return 0;
+	return SwitchStateResponseWrite(api_dev, &response);
 }
+
+static inline int esphome_switch_publish_state(const struct esphome_entity *entity)
+{
+	union esphome_entity_state value = {.raw = 0};
+	int state;
+	int ret;
+
+	ret = esphome_switch_get_state(entity->dev, &state);
+	if (ret) {
+		return ret;
+	}
+
+	value.on = state;
+
+	return esphome_entity_publish(entity, value, false);
+}
+
+#define DEFINE_ESPHOME_SWITCH_ENTITY(_num, name, _device_class)                                    \
+	DEFINE_ESPHOME_ENTITY_WITH_STATE(_num, name, _device_class, esphome_switch_list_entity,    \
+					 esphome_switch_send_state, NULL)
+#else
+#define DEFINE_ESPHOME_SWITCH_ENTITY(_num, name, _device_class)
 #endif
 
 #endif /* ESPHOME_SWITCH_COMPONENT */
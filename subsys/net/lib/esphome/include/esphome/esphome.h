@@ -26,8 +26,7 @@ struct esphome_config {
 	int port;
 };
 
-struct esphome_data {
-	int socket;
-};
+/* Run the on_shutdown automation, before rebooting */
+void esphome_shutdown(void);
 
 #endif /* __ESPHOME__ */
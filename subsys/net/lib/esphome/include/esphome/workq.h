@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ESPHOME_WORKQ_H
+#define ESPHOME_WORKQ_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/toolchain.h>
+
+/*
+ * ESPHome runs on a few shared execution contexts rather than a thread per
+ * component:
+ * - the network thread polls the sockets of the network services,
+ * - the actuation work queue drives the outputs,
+ * - the background work queue runs on_loop and the sensors.
+ * The OTA updates, which block for minutes, have their own thread.
+ */
+
+#ifdef CONFIG_ESPHOME_ACTUATION_WORKQ
+extern struct k_work_q esphome_actuation_workq;
+#endif
+extern struct k_work_q esphome_background_workq;
+
+/* Wraps a pollfd so that the pollfds of all the services form one array */
+struct esphome_net_pollfd {
+	struct zsock_pollfd fd;
+};
+
+BUILD_ASSERT(sizeof(struct esphome_net_pollfd) == sizeof(struct zsock_pollfd));
+
+/*
+ * A network service, whose callbacks are called by the network thread. init
+ * is called once, before the first poll. prepare fills the service pollfds
+ * and returns the poll timeout it needs in ms, -1 if none. handle is called
+ * after each poll, even when it timed out.
+ */
+struct esphome_net_service {
+	const char *name;
+	int (*init)(void *data);
+	int (*prepare)(void *data, struct zsock_pollfd *fds);
+	void (*handle)(void *data, struct zsock_pollfd *fds);
+	void *data;
+	struct zsock_pollfd *fds;
+	size_t nfds;
+	/* Cleared if init failed */
+	bool ready;
+};
+
+#define ESPHOME_NET_SERVICE_DEFINE(_name, _nfds, _init, _prepare, _handle, _data)                 \
+	static STRUCT_SECTION_ITERABLE_ARRAY(esphome_net_pollfd, _name##_pollfds, _nfds);         \
+	static STRUCT_SECTION_ITERABLE(esphome_net_service, _name) = {                            \
+		.name = #_name,                                                                    \
+		.init = _init,                                                                     \
+		.prepare = _prepare,                                                               \
+		.handle = _handle,                                                                 \
+		.data = _data,                                                                     \
+		.fds = &_name##_pollfds[0].fd,                                                     \
+		.nfds = _nfds,                                                                     \
+	}
+
+#endif /* ESPHOME_WORKQ_H */
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 Alexandre Bailon
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Generate the entities of the ESPHome API benchmark image.
+
+The overlay adds GPIO switches, driven by emulated GPIO controllers, and
+timestamp sensors to the ESPHome node of the native_sim sample. Switches
+are used to measure the command round-trip, timestamp sensors change at
+every read and produce a steady stream of state updates.
+"""
+
+import argparse
+
+GPIOS_PER_CONTROLLER = 32
+
+HEADER = """\
+/*
+ * Generated by gen_overlay.py --switches {switches} --sensors {sensors} --interval {interval}
+ */
+
+#include <zephyr/dt-bindings/gpio/gpio.h>
+
+"""
+
+CONTROLLER = """\
+/ {{
+	gpio_bench_{num}: gpio_bench_{num} {{
+		compatible = "zephyr,gpio-emul";
+		rising-edge;
+		falling-edge;
+		high-level;
+		low-level;
+		gpio-controller;
+		#gpio-cells = <2>;
+		status = "okay";
+	}};
+}};
+
+"""
+
+SWITCH = """\
+	bench-switch-{num} {{
+		compatible = "nabucasa,esphome-switch-gpio";
+		device_name = "Bench switch {num}";
+		gpios = <&gpio_bench_{controller} {pin} GPIO_ACTIVE_HIGH>;
+		status = "okay";
+	}};
+"""
+
+SENSOR = """\
+	bench-sensor-{num} {{
+		compatible = "nabucasa,esphome-sensor-timestamp";
+		device_class = "timestamp";
+		device_name = "Bench sensor {num}";
+		update_interval = <{interval}>;
+		status = "okay";
+	}};
+"""
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--switches", type=int, default=8, help="number of switches")
+    parser.add_argument("--sensors", type=int, default=4, help="number of sensors")
+    parser.add_argument("--interval", type=int, default=100,
+                        help="update interval of the sensors in ms")
+    parser.add_argument("--output", required=True, help="overlay to generate")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    controllers = (args.switches + GPIOS_PER_CONTROLLER - 1) // GPIOS_PER_CONTROLLER
+
+    with open(args.output, "w") as f:
+        f.write(HEADER.format(**vars(args)))
+        for num in range(controllers):
+            f.write(CONTROLLER.format(num=num))
+
+        f.write("&{/esphome} {\n")
+        for num in range(args.switches):
+            f.write(SWITCH.format(num=num, controller=num // GPIOS_PER_CONTROLLER,
+                                  pin=num % GPIOS_PER_CONTROLLER))
+        for num in range(args.sensors):
+            f.write(SENSOR.format(num=num, interval=args.interval))
+        f.write("};\n")
+
+
+if __name__ == "__main__":
+    main()
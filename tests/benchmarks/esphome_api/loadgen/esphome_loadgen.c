@@ -0,0 +1,764 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Load generator for the ESPHome native API (plaintext framing).
+ *
+ * It opens a number of client connections to the device and measures:
+ * - the time taken by each client to go from connect to Hello, Connect,
+ *   ListEntities and the first state,
+ * - the round-trip latency of switch commands (command to state),
+ * - the sustained rate of state updates received by all the clients.
+ *
+ * The messages are encoded and decoded by hand, only the few fields used
+ * here are handled, so that it builds without protobuf on the host.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#define HELLO_REQUEST                 1
+#define HELLO_RESPONSE                2
+#define CONNECT_REQUEST               3
+#define CONNECT_RESPONSE              4
+#define DISCONNECT_REQUEST            5
+#define DISCONNECT_RESPONSE           6
+#define PING_REQUEST                  7
+#define PING_RESPONSE                 8
+#define LIST_ENTITIES_REQUEST         11
+#define LIST_ENTITIES_SWITCH_RESPONSE 17
+#define LIST_ENTITIES_DONE_RESPONSE   19
+#define SUBSCRIBE_STATES_REQUEST      20
+#define BINARY_SENSOR_STATE_RESPONSE  21
+#define SENSOR_STATE_RESPONSE         25
+#define SWITCH_STATE_RESPONSE         26
+#define TEXT_SENSOR_STATE_RESPONSE    27
+#define SWITCH_COMMAND_REQUEST        33
+
+#define RX_BUFFER_SIZE 4096
+#define TX_BUFFER_SIZE 256
+#define MAX_SWITCHES   256
+
+enum client_phase {
+	PHASE_HELLO,
+	PHASE_CONNECT,
+	PHASE_LIST,
+	PHASE_FIRST_STATE,
+	PHASE_READY,
+};
+
+struct client {
+	int fd;
+	enum client_phase phase;
+	uint8_t rx_buf[RX_BUFFER_SIZE];
+	size_t rx_len;
+
+	/* Time at which each phase completed, relative to connect */
+	uint64_t start;
+	uint64_t connected;
+	uint64_t hello;
+	uint64_t login;
+	uint64_t listed;
+	uint64_t first_state;
+	unsigned int entities;
+
+	unsigned long states;
+	unsigned long bytes;
+};
+
+struct switch_entity {
+	uint32_t key;
+	bool state;
+};
+
+static struct {
+	const char *host;
+	const char *port;
+	const char *password;
+	unsigned int clients;
+	unsigned int commands;
+	unsigned int duration;
+	unsigned int timeout;
+	bool verbose;
+} options = {
+	.host = "192.0.2.1",
+	.port = "6053",
+	.password = "",
+	.clients = 1,
+	.commands = 1000,
+	.duration = 10,
+	.timeout = 5000,
+};
+
+static struct switch_entity switches[MAX_SWITCHES];
+static unsigned int nb_switches;
+
+/* Pending switch command, waiting for its state */
+static struct {
+	bool pending;
+	uint32_t key;
+	bool state;
+	uint64_t sent;
+} command;
+
+static uint64_t now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static size_t varint_encode(uint32_t value, uint8_t *buf)
+{
+	size_t len = 0;
+
+	while (value >= 0x80) {
+		buf[len++] = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+	buf[len++] = value;
+
+	return len;
+}
+
+/* Returns the number of bytes consumed, 0 if incomplete, -1 if invalid */
+static int varint_decode(const uint8_t *buf, size_t len, uint64_t *value)
+{
+	size_t i;
+
+	*value = 0;
+	for (i = 0; i < len && i < 10; i++) {
+		*value |= (uint64_t)(buf[i] & 0x7f) << (7 * i);
+		if (!(buf[i] & 0x80)) {
+			return i + 1;
+		}
+	}
+
+	return i == 10 ? -1 : 0;
+}
+
+static size_t pb_put_string(uint8_t *buf, uint32_t field, const char *str)
+{
+	size_t len = strlen(str);
+	size_t n = 0;
+
+	if (!len) {
+		return 0;
+	}
+
+	n += varint_encode(field << 3 | 2, buf + n);
+	n += varint_encode(len, buf + n);
+	memcpy(buf + n, str, len);
+
+	return n + len;
+}
+
+static size_t pb_put_varint(uint8_t *buf, uint32_t field, uint32_t value)
+{
+	size_t n;
+
+	if (!value) {
+		return 0;
+	}
+
+	n = varint_encode(field << 3, buf);
+
+	return n + varint_encode(value, buf + n);
+}
+
+static size_t pb_put_fixed32(uint8_t *buf, uint32_t field, uint32_t value)
+{
+	size_t n = varint_encode(field << 3 | 5, buf);
+
+	buf[n++] = value;
+	buf[n++] = value >> 8;
+	buf[n++] = value >> 16;
+	buf[n++] = value >> 24;
+
+	return n;
+}
+
+/*
+ * Look up a scalar field of a message. Varints and fixed32 are returned in
+ * value, length delimited fields are skipped. Returns 1 if found, 0 if not
+ * and -1 if the message is malformed.
+ */
+static int pb_get_field(const uint8_t *buf, size_t len, uint32_t field, uint64_t *value)
+{
+	size_t offset = 0;
+
+	while (offset < len) {
+		uint64_t tag, v;
+		int ret;
+
+		ret = varint_decode(buf + offset, len - offset, &tag);
+		if (ret <= 0) {
+			return -1;
+		}
+		offset += ret;
+
+		switch (tag & 7) {
+		case 0:
+			ret = varint_decode(buf + offset, len - offset, &v);
+			if (ret <= 0) {
+				return -1;
+			}
+			offset += ret;
+			break;
+		case 1:
+			if (len - offset < 8) {
+				return -1;
+			}
+			offset += 8;
+			v = 0;
+			break;
+		case 2:
+			ret = varint_decode(buf + offset, len - offset, &v);
+			if (ret <= 0 || len - offset - ret < v) {
+				return -1;
+			}
+			offset += ret + v;
+			break;
+		case 5:
+			if (len - offset < 4) {
+				return -1;
+			}
+			v = buf[offset] | buf[offset + 1] << 8 | buf[offset + 2] << 16 |
+			    (uint32_t)buf[offset + 3] << 24;
+			offset += 4;
+			break;
+		default:
+			return -1;
+		}
+
+		if ((tag >> 3) == field) {
+			*value = v;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int client_send(struct client *client, uint32_t msg_id, const uint8_t *body,
+		       size_t body_len)
+{
+	uint8_t buf[TX_BUFFER_SIZE];
+	size_t len = 1;
+	size_t offset = 0;
+
+	buf[0] = 0x00;
+	len += varint_encode(body_len, buf + len);
+	len += varint_encode(msg_id, buf + len);
+	memcpy(buf + len, body, body_len);
+	len += body_len;
+
+	while (offset < len) {
+		ssize_t ret = send(client->fd, buf + offset, len - offset, MSG_NOSIGNAL);
+
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			perror("send");
+			return -1;
+		}
+		offset += ret;
+	}
+
+	return 0;
+}
+
+static int client_connect(struct client *client)
+{
+	struct addrinfo hints = {
+		.ai_family = AF_UNSPEC,
+		.ai_socktype = SOCK_STREAM,
+	};
+	struct addrinfo *res, *ai;
+	uint8_t body[TX_BUFFER_SIZE];
+	size_t len = 0;
+	int one = 1;
+	int ret;
+
+	ret = getaddrinfo(options.host, options.port, &hints, &res);
+	if (ret) {
+		fprintf(stderr, "%s: %s\n", options.host, gai_strerror(ret));
+		return -1;
+	}
+
+	memset(client, 0, sizeof(*client));
+	client->fd = -1;
+	client->start = now_us();
+	for (ai = res; ai; ai = ai->ai_next) {
+		client->fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (client->fd < 0) {
+			continue;
+		}
+		if (!connect(client->fd, ai->ai_addr, ai->ai_addrlen)) {
+			break;
+		}
+		close(client->fd);
+		client->fd = -1;
+	}
+	freeaddrinfo(res);
+
+	if (client->fd < 0) {
+		fprintf(stderr, "Failed to connect to %s:%s\n", options.host, options.port);
+		return -1;
+	}
+	setsockopt(client->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	client->connected = now_us() - client->start;
+
+	len += pb_put_string(body + len, 1, "esphome-loadgen");
+	len += pb_put_varint(body + len, 2, 1);
+	len += pb_put_varint(body + len, 3, 10);
+	client->phase = PHASE_HELLO;
+
+	return client_send(client, HELLO_REQUEST, body, len);
+}
+
+static void switch_add(uint32_t key)
+{
+	unsigned int i;
+
+	for (i = 0; i < nb_switches; i++) {
+		if (switches[i].key == key) {
+			return;
+		}
+	}
+
+	if (nb_switches < MAX_SWITCHES) {
+		switches[nb_switches++].key = key;
+	}
+}
+
+static void switch_update(uint32_t key, bool state)
+{
+	unsigned int i;
+
+	for (i = 0; i < nb_switches; i++) {
+		if (switches[i].key == key) {
+			switches[i].state = state;
+			return;
+		}
+	}
+}
+
+static int client_handle(struct client *client, uint32_t msg_id, const uint8_t *body,
+			 size_t len)
+{
+	uint8_t req[TX_BUFFER_SIZE];
+	uint64_t key = 0, state = 0;
+	size_t req_len = 0;
+
+	if (options.verbose) {
+		fprintf(stderr, "[%d] message %u (%zu bytes)\n", client->fd, msg_id, len);
+	}
+
+	switch (msg_id) {
+	case HELLO_RESPONSE:
+		client->hello = now_us() - client->start;
+		req_len += pb_put_string(req, 1, options.password);
+		client->phase = PHASE_CONNECT;
+		return client_send(client, CONNECT_REQUEST, req, req_len);
+	case CONNECT_RESPONSE:
+		if (pb_get_field(body, len, 1, &state) > 0 && state) {
+			fprintf(stderr, "Invalid password\n");
+			return -1;
+		}
+		client->login = now_us() - client->start;
+		client->phase = PHASE_LIST;
+		return client_send(client, LIST_ENTITIES_REQUEST, NULL, 0);
+	case LIST_ENTITIES_DONE_RESPONSE:
+		client->listed = now_us() - client->start;
+		client->phase = PHASE_FIRST_STATE;
+		return client_send(client, SUBSCRIBE_STATES_REQUEST, NULL, 0);
+	case PING_REQUEST:
+		return client_send(client, PING_RESPONSE, NULL, 0);
+	case DISCONNECT_REQUEST:
+		client_send(client, DISCONNECT_RESPONSE, NULL, 0);
+		fprintf(stderr, "Disconnected by the device\n");
+		return -1;
+	case SWITCH_STATE_RESPONSE:
+		pb_get_field(body, len, 1, &key);
+		pb_get_field(body, len, 2, &state);
+		switch_update(key, state);
+		if (command.pending && command.key == key && command.state == !!state) {
+			command.pending = false;
+		}
+		break;
+	default:
+		break;
+	}
+
+	if (client->phase == PHASE_LIST) {
+		/* All the ListEntities responses have the key in field 2 */
+		if (pb_get_field(body, len, 2, &key) > 0) {
+			client->entities++;
+			if (msg_id == LIST_ENTITIES_SWITCH_RESPONSE) {
+				switch_add(key);
+			}
+		}
+		return 0;
+	}
+
+	if (msg_id >= BINARY_SENSOR_STATE_RESPONSE && msg_id <= TEXT_SENSOR_STATE_RESPONSE) {
+		if (client->phase == PHASE_FIRST_STATE) {
+			client->first_state = now_us() - client->start;
+			client->phase = PHASE_READY;
+		}
+		client->states++;
+	}
+
+	return 0;
+}
+
+static int client_read(struct client *client)
+{
+	size_t offset = 0;
+	ssize_t ret;
+
+	ret = recv(client->fd, client->rx_buf + client->rx_len,
+		   sizeof(client->rx_buf) - client->rx_len, 0);
+	if (ret <= 0) {
+		if (ret < 0 && errno == EINTR) {
+			return 0;
+		}
+		fprintf(stderr, "Connection closed by the device\n");
+		return -1;
+	}
+	client->rx_len += ret;
+	client->bytes += ret;
+
+	while (offset < client->rx_len) {
+		uint8_t *buf = client->rx_buf + offset;
+		size_t len = client->rx_len - offset;
+		uint64_t body_len, msg_id;
+		int n, m;
+
+		if (buf[0] != 0x00) {
+			fprintf(stderr, "Invalid preamble 0x%02x\n", buf[0]);
+			return -1;
+		}
+
+		n = varint_decode(buf + 1, len - 1, &body_len);
+		if (n <= 0) {
+			break;
+		}
+		m = varint_decode(buf + 1 + n, len - 1 - n, &msg_id);
+		if (m <= 0) {
+			break;
+		}
+		if (body_len > sizeof(client->rx_buf) - 1 - n - m) {
+			fprintf(stderr, "Message %lu too large (%lu bytes)\n",
+				(unsigned long)msg_id, (unsigned long)body_len);
+			return -1;
+		}
+		if (len < 1 + n + m + body_len) {
+			break;
+		}
+
+		if (client_handle(client, msg_id, buf + 1 + n + m, body_len)) {
+			return -1;
+		}
+		offset += 1 + n + m + body_len;
+	}
+
+	memmove(client->rx_buf, client->rx_buf + offset, client->rx_len - offset);
+	client->rx_len -= offset;
+
+	return 0;
+}
+
+/*
+ * Wait for data on all the clients, for at most timeout ms, and handle it.
+ * Returns -1 if a client failed.
+ */
+static int clients_poll(struct client *clients, unsigned int count, int timeout)
+{
+	struct pollfd fds[count];
+	unsigned int i;
+	int ret;
+
+	for (i = 0; i < count; i++) {
+		fds[i].fd = clients[i].fd;
+		fds[i].events = POLLIN;
+	}
+
+	ret = poll(fds, count, timeout);
+	if (ret < 0) {
+		if (errno == EINTR) {
+			return 0;
+		}
+		perror("poll");
+		return -1;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (fds[i].revents & (POLLIN | POLLERR | POLLHUP)) {
+			if (client_read(&clients[i])) {
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static uint64_t percentile(const uint64_t *values, unsigned int count, unsigned int pct)
+{
+	unsigned int i = (count * pct + 99) / 100;
+
+	return values[i ? i - 1 : 0];
+}
+
+static int bench_connect(struct client *clients)
+{
+	uint64_t deadline;
+	unsigned int i;
+
+	for (i = 0; i < options.clients; i++) {
+		if (client_connect(&clients[i])) {
+			return -1;
+		}
+
+		deadline = now_us() + options.timeout * 1000ULL;
+		while (clients[i].phase != PHASE_READY) {
+			if (now_us() > deadline) {
+				fprintf(stderr, "Client %u: timeout waiting for the first state\n", i);
+				return -1;
+			}
+			if (clients_poll(clients, i + 1, options.timeout)) {
+				return -1;
+			}
+		}
+
+		printf("client %u: connect %.3f ms, hello %.3f ms, login %.3f ms, "
+		       "list %u entities %.3f ms, first state %.3f ms\n",
+		       i, clients[i].connected / 1000.0, clients[i].hello / 1000.0,
+		       clients[i].login / 1000.0, clients[i].entities, clients[i].listed / 1000.0,
+		       clients[i].first_state / 1000.0);
+	}
+
+	return 0;
+}
+
+static int bench_commands(struct client *clients)
+{
+	uint64_t *latencies;
+	uint64_t deadline;
+	unsigned int i;
+	int ret = -1;
+
+	if (!nb_switches || !options.commands) {
+		printf("commands: skipped, no switch\n");
+		return 0;
+	}
+
+	latencies = calloc(options.commands, sizeof(*latencies));
+	if (!latencies) {
+		return -1;
+	}
+
+	for (i = 0; i < options.commands; i++) {
+		struct switch_entity *sw = &switches[i % nb_switches];
+		uint8_t body[16];
+		size_t len = 0;
+
+		command.key = sw->key;
+		command.state = !sw->state;
+		command.pending = true;
+		len += pb_put_fixed32(body + len, 1, command.key);
+		len += pb_put_varint(body + len, 2, command.state);
+
+		command.sent = now_us();
+		if (client_send(&clients[0], SWITCH_COMMAND_REQUEST, body, len)) {
+			goto out;
+		}
+
+		deadline = command.sent + options.timeout * 1000ULL;
+		while (command.pending) {
+			if (now_us() > deadline) {
+				fprintf(stderr, "Timeout waiting for the state of 0x%08x\n",
+					command.key);
+				goto out;
+			}
+			if (clients_poll(clients, options.clients, options.timeout)) {
+				goto out;
+			}
+		}
+		latencies[i] = now_us() - command.sent;
+	}
+
+	qsort(latencies, options.commands, sizeof(*latencies), compare_u64);
+	printf("commands: %u round-trips, p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+	       options.commands, percentile(latencies, options.commands, 50) / 1000.0,
+	       percentile(latencies, options.commands, 90) / 1000.0,
+	       percentile(latencies, options.commands, 99) / 1000.0,
+	       latencies[options.commands - 1] / 1000.0);
+	ret = 0;
+
+out:
+	free(latencies);
+
+	return ret;
+}
+
+static int bench_states(struct client *clients)
+{
+	unsigned long states = 0, bytes = 0;
+	uint64_t start, end, elapsed;
+	unsigned int i;
+
+	for (i = 0; i < options.clients; i++) {
+		clients[i].states = 0;
+		clients[i].bytes = 0;
+	}
+
+	start = now_us();
+	end = start + options.duration * 1000000ULL;
+	while (now_us() < end) {
+		if (clients_poll(clients, options.clients, (end - now_us()) / 1000 + 1)) {
+			return -1;
+		}
+	}
+	elapsed = now_us() - start;
+
+	for (i = 0; i < options.clients; i++) {
+		printf("client %u: %lu states, %.1f states/s, %.1f KiB/s\n", i, clients[i].states,
+		       clients[i].states * 1e6 / elapsed, clients[i].bytes * 1e6 / elapsed / 1024);
+		states += clients[i].states;
+		bytes += clients[i].bytes;
+	}
+	printf("states: %lu in %.3f s, %.1f states/s, %.1f KiB/s\n", states, elapsed / 1e6,
+	       states * 1e6 / elapsed, bytes * 1e6 / elapsed / 1024);
+
+	return 0;
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+		"Usage: %s [options]\n"
+		"  -H, --host HOST          device address (default %s)\n"
+		"  -p, --port PORT          API port (default %s)\n"
+		"  -P, --password PASSWORD  API password\n"
+		"  -c, --clients N          number of clients (default %u)\n"
+		"  -n, --commands N         number of switch commands (default %u)\n"
+		"  -d, --duration S         duration of the state measurement (default %u)\n"
+		"  -t, --timeout MS         timeout of each step (default %u)\n"
+		"  -v, --verbose            print the received messages\n",
+		name, options.host, options.port, options.clients, options.commands,
+		options.duration, options.timeout);
+}
+
+int main(int argc, char **argv)
+{
+	static const struct option long_options[] = {
+		{"host", required_argument, NULL, 'H'},
+		{"port", required_argument, NULL, 'p'},
+		{"password", required_argument, NULL, 'P'},
+		{"clients", required_argument, NULL, 'c'},
+		{"commands", required_argument, NULL, 'n'},
+		{"duration", required_argument, NULL, 'd'},
+		{"timeout", required_argument, NULL, 't'},
+		{"verbose", no_argument, NULL, 'v'},
+		{"help", no_argument, NULL, 'h'},
+		{},
+	};
+	struct client *clients;
+	unsigned int i;
+	int ret;
+	int opt;
+
+	while ((opt = getopt_long(argc, argv, "H:p:P:c:n:d:t:vh", long_options, NULL)) != -1) {
+		switch (opt) {
+		case 'H':
+			options.host = optarg;
+			break;
+		case 'p':
+			options.port = optarg;
+			break;
+		case 'P':
+			options.password = optarg;
+			break;
+		case 'c':
+			options.clients = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			options.commands = strtoul(optarg, NULL, 0);
+			break;
+		case 'd':
+			options.duration = strtoul(optarg, NULL, 0);
+			break;
+		case 't':
+			options.timeout = strtoul(optarg, NULL, 0);
+			break;
+		case 'v':
+			options.verbose = true;
+			break;
+		default:
+			usage(argv[0]);
+			return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	if (!options.clients) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	clients = calloc(options.clients, sizeof(*clients));
+	if (!clients) {
+		return EXIT_FAILURE;
+	}
+	for (i = 0; i < options.clients; i++) {
+		clients[i].fd = -1;
+	}
+
+	ret = bench_connect(clients);
+	if (!ret) {
+		printf("entities: %u, switches: %u\n", clients[0].entities, nb_switches);
+		ret = bench_commands(clients);
+	}
+	if (!ret) {
+		ret = bench_states(clients);
+	}
+
+	for (i = 0; i < options.clients; i++) {
+		if (clients[i].fd >= 0) {
+			client_send(&clients[i], DISCONNECT_REQUEST, NULL, 0);
+			close(clients[i].fd);
+		}
+	}
+	free(clients);
+
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/socket.h>
+
+#define API_PORT 6053
+
+#define HELLO_REQUEST            1
+#define HELLO_RESPONSE           2
+#define CONNECT_REQUEST          3
+#define CONNECT_RESPONSE         4
+#define SUBSCRIBE_STATES_REQUEST 20
+#define SWITCH_STATE_RESPONSE    26
+
+/* Time the device is given to answer */
+#define REPLY_TIMEOUT_MS 1000
+
+struct esphome_api_tests_fixture {
+	int fd;
+	uint8_t rx_buf[512];
+	size_t rx_len;
+};
+
+static int api_connect(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(API_PORT),
+	};
+	int fd;
+
+	zsock_inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+	/* The server is started by the network thread */
+	for (int i = 0; i < 10; i++) {
+		fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		zassert_true(fd >= 0);
+
+		if (!zsock_connect(fd, (struct sockaddr *)&addr, sizeof(addr))) {
+			return fd;
+		}
+
+		zsock_close(fd);
+		k_msleep(100);
+	}
+
+	zassert_unreachable("Can't connect to the API server");
+	return -1;
+}
+
+static size_t put_varint(uint8_t *buf, uint32_t value)
+{
+	size_t len = 0;
+
+	do {
+		buf[len] = value & 0x7f;
+		value >>= 7;
+		if (value) {
+			buf[len] |= 0x80;
+		}
+		len++;
+	} while (value);
+
+	return len;
+}
+
+/* Returns the length of the varint, 0 if it is incomplete */
+static size_t get_varint(const uint8_t *buf, size_t len, uint32_t *value)
+{
+	*value = 0;
+	for (size_t i = 0; i < len && i < 5; i++) {
+		*value |= (uint32_t)(buf[i] & 0x7f) << (i * 7);
+		if (!(buf[i] & 0x80)) {
+			return i + 1;
+		}
+	}
+
+	return 0;
+}
+
+/* Plaintext frame: a zero byte, the body length and the message type */
+static void api_send(struct esphome_api_tests_fixture *fixture, uint32_t type,
+		     const uint8_t *body, size_t len)
+{
+	uint8_t frame[64] = {0};
+	size_t pos = 1;
+
+	pos += put_varint(frame + pos, len);
+	pos += put_varint(frame + pos, type);
+	if (len) {
+		memcpy(frame + pos, body, len);
+		pos += len;
+	}
+
+	zassert_equal(zsock_send(fixture->fd, frame, pos, 0), pos);
+}
+
+/*
+ * Returns the type of the next message, -EAGAIN if none came in time, or
+ * -ENOTCONN once the device closed the connection.
+ */
+static int api_recv(struct esphome_api_tests_fixture *fixture)
+{
+	struct zsock_pollfd pfd = {.fd = fixture->fd, .events = ZSOCK_POLLIN};
+	uint32_t len;
+	uint32_t type;
+	size_t hdr_len;
+	size_t type_len;
+	ssize_t received;
+
+	while (1) {
+		if (fixture->rx_len > 1) {
+			zassert_equal(fixture->rx_buf[0], 0);
+			hdr_len = get_varint(fixture->rx_buf + 1, fixture->rx_len - 1, &len);
+			type_len = hdr_len ? get_varint(fixture->rx_buf + 1 + hdr_len,
+							fixture->rx_len - 1 - hdr_len, &type)
+					   : 0;
+			hdr_len = type_len ? 1 + hdr_len + type_len : 0;
+			if (hdr_len && fixture->rx_len >= hdr_len + len) {
+				fixture->rx_len -= hdr_len + len;
+				memmove(fixture->rx_buf, fixture->rx_buf + hdr_len + len,
+					fixture->rx_len);
+				return type;
+			}
+		}
+
+		if (zsock_poll(&pfd, 1, REPLY_TIMEOUT_MS) == 0) {
+			return -EAGAIN;
+		}
+
+		received = zsock_recv(fixture->fd, fixture->rx_buf + fixture->rx_len,
+				      sizeof(fixture->rx_buf) - fixture->rx_len, 0);
+		if (received <= 0) {
+			return -ENOTCONN;
+		}
+		fixture->rx_len += received;
+	}
+}
+
+static void api_hello(struct esphome_api_tests_fixture *fixture)
+{
+	api_send(fixture, HELLO_REQUEST, NULL, 0);
+	zassert_equal(api_recv(fixture), HELLO_RESPONSE);
+}
+
+static void api_login(struct esphome_api_tests_fixture *fixture, const char *password)
+{
+	uint8_t body[32];
+	size_t len = strlen(password);
+
+	/* ConnectRequest.password, field 1 */
+	body[0] = 0x0a;
+	body[1] = len;
+	memcpy(body + 2, password, len);
+
+	api_send(fixture, CONNECT_REQUEST, body, len + 2);
+	zassert_equal(api_recv(fixture), CONNECT_RESPONSE);
+}
+
+/* Nothing but the end of the connection must follow a refused subscription */
+static void api_subscribe_refused(struct esphome_api_tests_fixture *fixture)
+{
+	api_send(fixture, SUBSCRIBE_STATES_REQUEST, NULL, 0);
+	zassert_equal(api_recv(fixture), -ENOTCONN);
+}
+
+static void *api_setup(void)
+{
+	static struct esphome_api_tests_fixture fixture;
+
+	return &fixture;
+}
+
+static void api_before(void *f)
+{
+	struct esphome_api_tests_fixture *fixture = f;
+
+	fixture->rx_len = 0;
+	fixture->fd = api_connect();
+}
+
+static void api_after(void *f)
+{
+	struct esphome_api_tests_fixture *fixture = f;
+
+	zsock_close(fixture->fd);
+}
+
+ZTEST_SUITE(esphome_api_tests, NULL, api_setup, api_before, api_after, NULL);
+
+ZTEST_F(esphome_api_tests, test_esphome_api_subscribe_states_before_hello)
+{
+	api_subscribe_refused(fixture);
+}
+
+ZTEST_F(esphome_api_tests, test_esphome_api_subscribe_states_before_connect)
+{
+	api_hello(fixture);
+	api_subscribe_refused(fixture);
+}
+
+ZTEST_F(esphome_api_tests, test_esphome_api_subscribe_states_invalid_password)
+{
+	api_hello(fixture);
+	api_login(fixture, "wrongpassword");
+	api_subscribe_refused(fixture);
+}
+
+ZTEST_F(esphome_api_tests, test_esphome_api_subscribe_states)
+{
+	api_hello(fixture);
+	api_login(fixture, "mypassword");
+
+	api_send(fixture, SUBSCRIBE_STATES_REQUEST, NULL, 0);
+	zassert_equal(api_recv(fixture), SWITCH_STATE_RESPONSE);
+}
@@ -15,6 +15,8 @@
 #include <zephyr/fff.h>
 DEFINE_FFF_GLOBALS;
 
+#define HBRIDGE_WAIT_TIME DT_PROP(DT_PATH(hbridge_switch), wait_time)
+
 struct esphome_hbridge_tests_fixture {
 	const struct device *dev;
 	const struct gpio_dt_spec gpio_on;
@@ -31,7 +33,21 @@ static void *switch_hbridge_setup(void)
 	return &fixture;
 }
 
-ZTEST_SUITE(esphome_hbridge_tests, NULL, switch_hbridge_setup, NULL, NULL, NULL);
+static void switch_hbridge_before(void *f)
+{
+	RESET_FAKE(gpio_fake_port_set_bits_raw);
+	RESET_FAKE(gpio_fake_port_clear_bits_raw);
+	RESET_FAKE(gpio_fake_port_set_masked_raw);
+	FFF_RESET_HISTORY();
+}
+
+/* The pulses are ended asynchronously, by the actuation work queue */
+static void switch_hbridge_wait_pulse(void)
+{
+	k_sleep(K_MSEC(HBRIDGE_WAIT_TIME + 10));
+}
+
+ZTEST_SUITE(esphome_hbridge_tests, NULL, switch_hbridge_setup, switch_hbridge_before, NULL, NULL);
 
 ZTEST_F(esphome_hbridge_tests, test_esphome_switch_hbridge_set_state_off)
 {
@@ -49,7 +65,8 @@ ZTEST_F(esphome_hbridge_tests, test_esphome_switch_hbridge_set_state_off)
 	zassert_equal(fixture->gpio_off.port, gpio_fake_port_set_bits_raw_fake.arg0_history[0]);
 	zassert_equal(2, gpio_fake_port_set_bits_raw_fake.arg1_history[0]);
 
-	/* To finish we clear both gpios */
+	/* To finish we clear both gpios, once the pulse ends */
+	switch_hbridge_wait_pulse();
 	zassert_equal(fixture->gpio_on.port, gpio_fake_port_clear_bits_raw_fake.arg0_history[1]);
 	zassert_equal(1, gpio_fake_port_clear_bits_raw_fake.arg1_history[1]);
 	zassert_equal(fixture->gpio_off.port, gpio_fake_port_clear_bits_raw_fake.arg0_history[2]);
@@ -72,7 +89,8 @@ ZTEST_F(esphome_hbridge_tests, test_esphome_switch_hbridge_set_state_on)
 	zassert_equal(fixture->gpio_on.port, gpio_fake_port_clear_bits_raw_fake.arg0_history[0]);
 	zassert_equal(2, gpio_fake_port_clear_bits_raw_fake.arg1_history[0]);
 
-	/* To finish we clear both gpios */
+	/* To finish we clear both gpios, once the pulse ends */
+	switch_hbridge_wait_pulse();
 	zassert_equal(fixture->gpio_on.port, gpio_fake_port_clear_bits_raw_fake.arg0_history[1]);
 	zassert_equal(1, gpio_fake_port_clear_bits_raw_fake.arg1_history[1]);
 	zassert_equal(fixture->gpio_off.port, gpio_fake_port_clear_bits_raw_fake.arg0_history[2]);
@@ -86,14 +104,95 @@ ZTEST_F(esphome_hbridge_tests, test_esphome_switch_hbridge_get_state)
 
 	ret = esphome_switch_set_state(fixture->dev, 1);
 	zassert_equal(ret, 0);
+	switch_hbridge_wait_pulse();
+
+	ret = esphome_switch_get_state(fixture->dev, &state);
+	zassert_equal(ret, 0);
+	zassert_equal(state, 1);
+
+	ret = esphome_switch_set_state(fixture->dev, 0);
+	zassert_equal(ret, 0);
 
+	/* The state changes once the pulse ends */
 	ret = esphome_switch_get_state(fixture->dev, &state);
 	zassert_equal(ret, 0);
 	zassert_equal(state, 1);
+	switch_hbridge_wait_pulse();
+
+	ret = esphome_switch_get_state(fixture->dev, &state);
+	zassert_equal(ret, 0);
+	zassert_equal(state, 0);
+}
+
+ZTEST_F(esphome_hbridge_tests, test_esphome_switch_hbridge_set_state_async)
+{
+	int64_t start = k_uptime_get();
+	int ret;
+
+	ret = esphome_switch_set_state(fixture->dev, 1);
+	zassert_equal(ret, 0);
+
+	/* The caller doesn't wait for the pulse */
+	zassert_true(k_uptime_get() - start < HBRIDGE_WAIT_TIME);
+	zassert_equal(gpio_fake_port_clear_bits_raw_fake.call_count, 1);
+
+	switch_hbridge_wait_pulse();
+	zassert_equal(gpio_fake_port_clear_bits_raw_fake.call_count, 3);
+}
+
+ZTEST_F(esphome_hbridge_tests, test_esphome_switch_hbridge_reverse_pulse)
+{
+	int state;
+	int ret;
+
+	ret = esphome_switch_set_state(fixture->dev, 1);
+	zassert_equal(ret, 0);
 
+	/* Reversed before the pulse ends */
 	ret = esphome_switch_set_state(fixture->dev, 0);
 	zassert_equal(ret, 0);
 
+	/* The on gpio is cleared before the off gpio is set, never both high */
+	zassert_equal(fff.call_history[2], (void *)gpio_fake_port_clear_bits_raw);
+	zassert_equal(1, gpio_fake_port_clear_bits_raw_fake.arg1_history[1]);
+	zassert_equal(fff.call_history[3], (void *)gpio_fake_port_set_bits_raw);
+	zassert_equal(2, gpio_fake_port_set_bits_raw_fake.arg1_history[1]);
+
+	/* A single pulse end, for the last state */
+	switch_hbridge_wait_pulse();
+	zassert_equal(gpio_fake_port_clear_bits_raw_fake.call_count, 4);
+
+	ret = esphome_switch_get_state(fixture->dev, &state);
+	zassert_equal(ret, 0);
+	zassert_equal(state, 0);
+}
+
+ZTEST_F(esphome_hbridge_tests, test_esphome_switch_hbridge_batch_port_error)
+{
+	struct esphome_switch_batch batch;
+	int clear_calls;
+	int state;
+	int ret;
+
+	ret = esphome_switch_set_state(fixture->dev, 0);
+	zassert_equal(ret, 0);
+	switch_hbridge_wait_pulse();
+	clear_calls = gpio_fake_port_clear_bits_raw_fake.call_count;
+
+	esphome_switch_batch_init(&batch);
+	ret = esphome_switch_batch_add(&batch, fixture->dev, 1);
+	zassert_equal(ret, 0);
+
+	gpio_fake_port_set_masked_raw_fake.return_val = -EIO;
+	ret = esphome_switch_batch_apply(&batch);
+	gpio_fake_port_set_masked_raw_fake.return_val = 0;
+	zassert_equal(ret, -EIO);
+	zassert_equal(gpio_fake_port_set_masked_raw_fake.call_count, 1);
+
+	/* No pulse was started, the switch keeps its state */
+	switch_hbridge_wait_pulse();
+	zassert_equal(gpio_fake_port_clear_bits_raw_fake.call_count, clear_calls);
+
 	ret = esphome_switch_get_state(fixture->dev, &state);
 	zassert_equal(ret, 0);
 	zassert_equal(state, 0);
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <mbedtls/md5.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ESPHomeOTA);
+
+#include "esphome_ota_delta.h"
+
+#define OLD_SIZE     256
+#define NEW_SIZE     208
+#define MAX_NEW_SIZE 4096
+#define EXTRA        "ESPHome delta OK"
+#define EXTRA_LEN    (sizeof(EXTRA) - 1)
+
+struct esphome_ota_delta_tests_fixture {
+	struct esphome_ota_delta delta;
+	uint8_t old[OLD_SIZE];
+	uint8_t old_md5[16];
+	/* Image rebuilt from the patch */
+	uint8_t new[NEW_SIZE];
+	uint8_t patch[512];
+	size_t patch_len;
+	uint8_t out[NEW_SIZE];
+	size_t out_len;
+};
+
+static int test_write(struct esphome_ota_delta *delta, const uint8_t *data, size_t len)
+{
+	struct esphome_ota_delta_tests_fixture *fixture =
+		CONTAINER_OF(delta, struct esphome_ota_delta_tests_fixture, delta);
+
+	if (len > sizeof(fixture->out) - fixture->out_len) {
+		return -ENOSPC;
+	}
+
+	memcpy(fixture->out + fixture->out_len, data, len);
+	fixture->out_len += len;
+
+	return 0;
+}
+
+static void patch_header(struct esphome_ota_delta_tests_fixture *fixture, uint32_t new_size)
+{
+	uint8_t *header = fixture->patch + fixture->patch_len;
+
+	sys_put_le32(ESPHOME_OTA_DELTA_MAGIC, header);
+	sys_put_le32(OLD_SIZE, header + 4);
+	memcpy(header + 8, fixture->old_md5, sizeof(fixture->old_md5));
+	sys_put_le32(new_size, header + 24);
+	fixture->patch_len += ESPHOME_OTA_DELTA_HEADER_SIZE;
+}
+
+static void patch_record(struct esphome_ota_delta_tests_fixture *fixture, uint32_t diff_len,
+			 uint32_t extra_len, int32_t seek)
+{
+	uint8_t *record = fixture->patch + fixture->patch_len;
+
+	sys_put_le32(diff_len, record);
+	sys_put_le32(extra_len, record + 4);
+	sys_put_le32(seek, record + 8);
+	fixture->patch_len += ESPHOME_OTA_DELTA_RECORD_SIZE;
+}
+
+static void patch_data(struct esphome_ota_delta_tests_fixture *fixture, const uint8_t *data,
+		       size_t len)
+{
+	memcpy(fixture->patch + fixture->patch_len, data, len);
+	fixture->patch_len += len;
+}
+
+/*
+ * The first 128 bytes of the old image, every eighth one incremented, the
+ * extra, then the last 64 bytes of the old image.
+ */
+static void patch_image(struct esphome_ota_delta_tests_fixture *fixture)
+{
+	uint8_t diff[128];
+
+	for (size_t i = 0; i < sizeof(diff); i++) {
+		diff[i] = i % 8 ? 0 : 1;
+		fixture->new[i] = fixture->old[i] + diff[i];
+	}
+	memcpy(fixture->new + 128, EXTRA, EXTRA_LEN);
+	memcpy(fixture->new + 128 + EXTRA_LEN, fixture->old + 192, 64);
+
+	patch_header(fixture, NEW_SIZE);
+	patch_record(fixture, sizeof(diff), EXTRA_LEN, 64);
+	patch_data(fixture, diff, sizeof(diff));
+	patch_data(fixture, (const uint8_t *)EXTRA, EXTRA_LEN);
+	memset(diff, 0, sizeof(diff));
+	patch_record(fixture, 64, 0, 0);
+	patch_data(fixture, diff, 64);
+}
+
+static void *ota_delta_setup(void)
+{
+	static struct esphome_ota_delta_tests_fixture fixture;
+	const struct flash_area *fa;
+	struct flash_pages_info info;
+	int ret;
+
+	for (int i = 0; i < OLD_SIZE; i++) {
+		fixture.old[i] = i ^ 0x5a;
+	}
+	zassert_equal(mbedtls_md5(fixture.old, OLD_SIZE, fixture.old_md5), 0);
+
+	/* The old image is the one running, in the primary slot */
+	ret = flash_area_open(FIXED_PARTITION_ID(slot0_partition), &fa);
+	zassert_equal(ret, 0);
+	ret = flash_get_page_info_by_offs(flash_area_get_device(fa), fa->fa_off, &info);
+	zassert_equal(ret, 0);
+	ret = flash_area_erase(fa, 0, info.size);
+	zassert_equal(ret, 0);
+	ret = flash_area_write(fa, 0, fixture.old, OLD_SIZE);
+	zassert_equal(ret, 0);
+	flash_area_close(fa);
+
+	return &fixture;
+}
+
+static void ota_delta_before(void *f)
+{
+	struct esphome_ota_delta_tests_fixture *fixture = f;
+
+	fixture->patch_len = 0;
+	fixture->out_len = 0;
+	fixture->delta.write = test_write;
+	fixture->delta.max_new_size = MAX_NEW_SIZE;
+	zassert_equal(esphome_ota_delta_init(&fixture->delta), 0);
+}
+
+ZTEST_SUITE(esphome_ota_delta_tests, NULL, ota_delta_setup, ota_delta_before, NULL, NULL);
+
+ZTEST_F(esphome_ota_delta_tests, test_esphome_ota_delta_apply)
+{
+	int ret;
+
+	patch_image(fixture);
+
+	ret = esphome_ota_delta_write(&fixture->delta, fixture->patch, fixture->patch_len);
+	zassert_equal(ret, 0);
+	ret = esphome_ota_delta_finish(&fixture->delta);
+	zassert_equal(ret, 0);
+	zassert_equal(fixture->out_len, NEW_SIZE);
+	zassert_mem_equal(fixture->out, fixture->new, NEW_SIZE);
+}
+
+ZTEST_F(esphome_ota_delta_tests, test_esphome_ota_delta_apply_byte_by_byte)
+{
+	int ret;
+
+	patch_image(fixture);
+
+	/* The headers and records can be split anywhere */
+	for (size_t i = 0; i < fixture->patch_len; i++) {
+		ret = esphome_ota_delta_write(&fixture->delta, fixture->patch + i, 1);
+		zassert_equal(ret, 0);
+	}
+	ret = esphome_ota_delta_finish(&fixture->delta);
+	zassert_equal(ret, 0);
+	zassert_equal(fixture->out_len, NEW_SIZE);
+	zassert_mem_equal(fixture->out, fixture->new, NEW_SIZE);
+}
+
+ZTEST_F(esphome_ota_delta_tests, test_esphome_ota_delta_other_image)
+{
+	int ret;
+
+	patch_image(fixture);
+	/* Made from another image */
+	fixture->patch[8] ^= 0xff;
+
+	ret = esphome_ota_delta_write(&fixture->delta, fixture->patch, fixture->patch_len);
+	zassert_equal(ret, -ESTALE);
+	zassert_equal(fixture->out_len, 0);
+	esphome_ota_delta_finish(&fixture->delta);
+}
+
+ZTEST_F(esphome_ota_delta_tests, test_esphome_ota_delta_new_image_too_large)
+{
+	int ret;
+
+	patch_header(fixture, MAX_NEW_SIZE + 1);
+
+	ret = esphome_ota_delta_write(&fixture->delta, fixture->patch, fixture->patch_len);
+	zassert_equal(ret, -EFBIG);
+	esphome_ota_delta_finish(&fixture->delta);
+}
+
+ZTEST_F(esphome_ota_delta_tests, test_esphome_ota_delta_seek_out_of_range)
+{
+	int ret;
+
+	patch_header(fixture, NEW_SIZE);
+	patch_record(fixture, 0, 0, -1);
+
+	ret = esphome_ota_delta_write(&fixture->delta, fixture->patch, fixture->patch_len);
+	zassert_equal(ret, -EBADMSG);
+
+	esphome_ota_delta_finish(&fixture->delta);
+	zassert_equal(esphome_ota_delta_init(&fixture->delta), 0);
+	fixture->patch_len = 0;
+	patch_header(fixture, NEW_SIZE);
+	patch_record(fixture, 0, 0, OLD_SIZE + 1);
+
+	ret = esphome_ota_delta_write(&fixture->delta, fixture->patch, fixture->patch_len);
+	zassert_equal(ret, -EBADMSG);
+	esphome_ota_delta_finish(&fixture->delta);
+}
+
+ZTEST_F(esphome_ota_delta_tests, test_esphome_ota_delta_diff_out_of_range)
+{
+	int ret;
+
+	patch_header(fixture, NEW_SIZE);
+	patch_record(fixture, OLD_SIZE + 1, 0, 0);
+
+	ret = esphome_ota_delta_write(&fixture->delta, fixture->patch, fixture->patch_len);
+	zassert_equal(ret, -EBADMSG);
+	zassert_equal(fixture->out_len, 0);
+	esphome_ota_delta_finish(&fixture->delta);
+}
+
+ZTEST_F(esphome_ota_delta_tests, test_esphome_ota_delta_wrapping_length)
+{
+	int ret;
+
+	/* The sum of the lengths, on 32 bits, would fit in the new image */
+	patch_header(fixture, NEW_SIZE);
+	patch_record(fixture, 16, UINT32_MAX - 7, 0);
+
+	ret = esphome_ota_delta_write(&fixture->delta, fixture->patch, fixture->patch_len);
+	zassert_equal(ret, -EBADMSG);
+	zassert_equal(fixture->out_len, 0);
+	esphome_ota_delta_finish(&fixture->delta);
+}
+
+ZTEST_F(esphome_ota_delta_tests, test_esphome_ota_delta_incomplete)
+{
+	int ret;
+
+	patch_image(fixture);
+
+	ret = esphome_ota_delta_write(&fixture->delta, fixture->patch, fixture->patch_len - 1);
+	zassert_equal(ret, 0);
+	ret = esphome_ota_delta_finish(&fixture->delta);
+	zassert_equal(ret, -EBADMSG);
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2025 Alexandre Bailon
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include "esphome_ota_inflate.h"
+
+#define STORED_SIZE  600
+#define DYNAMIC_SIZE 2000
+
+/* "ESPHome OTA, ESPHome OTA, ESPHome OTA", fixed Huffman codes */
+static const uint8_t fixed_stream[] = {
+	0x73, 0x0d, 0x0e, 0xf0, 0xc8, 0xcf, 0x4d, 0x55, 0xf0, 0x0f,
+	0x71, 0xd4, 0x51, 0x70, 0xc5, 0xc1, 0x01, 0x00,
+};
+
+/* dynamic_image(), compressed with a 512 bytes window */
+static const uint8_t dynamic_stream[] = {
+	0x6d, 0xcf, 0xb9, 0x4d, 0x44, 0x51, 0x0c, 0x00, 0xc0, 0x9c, 0x2a, 0x7e,
+	0x09, 0xf8, 0xf9, 0x1d, 0x76, 0x39, 0x2c, 0x5a, 0x0e, 0x01, 0xda, 0x84,
+	0xfe, 0x85, 0x44, 0x3c, 0xe9, 0x64, 0x73, 0xfb, 0x7e, 0xbc, 0x7e, 0x5d,
+	0xcf, 0xd7, 0xe3, 0xed, 0xfa, 0xfd, 0xb8, 0x5f, 0x9f, 0x3f, 0x2f, 0xef,
+	0xf7, 0xa7, 0xdb, 0x3f, 0x1e, 0x61, 0x4c, 0xe9, 0x08, 0x6a, 0x49, 0x73,
+	0x49, 0xe7, 0xa0, 0xb6, 0x74, 0x6d, 0xe9, 0x4e, 0x26, 0x5c, 0xe3, 0xad,
+	0x78, 0x6b, 0xde, 0x9a, 0x37, 0xd6, 0x82, 0xb5, 0x60, 0x6d, 0xb0, 0x96,
+	0xac, 0x4d, 0xd6, 0x26, 0x6b, 0x8b, 0xb5, 0xcd, 0xda, 0x66, 0xed, 0xf0,
+	0x56, 0xbc, 0x15, 0x6f, 0xed, 0x9b, 0x30, 0x58, 0x0b, 0xd6, 0x06, 0x6b,
+	0xc9, 0x5a, 0xb2, 0x36, 0x59, 0x5b, 0xac, 0x2d, 0xd6, 0x36, 0x6b, 0x87,
+	0xb7, 0xe2, 0xad, 0x78, 0x6b, 0xde, 0x58, 0xe3, 0x2c, 0x38, 0x1b, 0x9c,
+	0x0d, 0xce, 0x92, 0xb3, 0xc9, 0xd9, 0xe2, 0x6c, 0x71, 0xb6, 0x39, 0x3b,
+	0xac, 0x1d, 0xde, 0x8a, 0xb7, 0xe6, 0xad, 0x79, 0x63, 0x2d, 0x58, 0x1b,
+	0xac, 0x0d, 0xd6, 0x92, 0xb5, 0xc9, 0xda, 0x64, 0x6d, 0xb1, 0xb6, 0x59,
+	0xdb, 0xac, 0x1d, 0xde, 0x8a, 0xb7, 0xe6, 0xad, 0x79, 0x63, 0x2d, 0x58,
+	0x0b, 0xd6, 0x06, 0x6b, 0xc9, 0x5a, 0xb2, 0x36, 0x59, 0x5b, 0xac, 0x6d,
+	0xd6, 0x36, 0x6b, 0x87, 0xb7, 0xe2, 0xad, 0x78, 0x6b, 0xde, 0x58, 0xe3,
+	0x2c, 0x38, 0x1b, 0x9c, 0x25, 0x67, 0x79, 0xfe, 0x00,
+};
+
+/* Fixed block starting with a back reference, before any output */
+static const uint8_t far_stream[] = {0x03, 0x02, 0x00};
+
+struct esphome_ota_inflate_tests_fixture {
+	struct esphome_ota_inflate inflate;
+	const uint8_t *in;
+	size_t in_len;
+	size_t in_pos;
+	uint8_t out[DYNAMIC_SIZE];
+	size_t out_len;
+	int write_calls;
+};
+
+static int test_read_byte(struct esphome_ota_inflate *inflate)
+{
+	struct esphome_ota_inflate_tests_fixture *fixture =
+		CONTAINER_OF(inflate, struct esphome_ota_inflate_tests_fixture, inflate);
+
+	if (fixture->in_pos == fixture->in_len) {
+		return -ENODATA;
+	}
+
+	return fixture->in[fixture->in_pos++];
+}
+
+static int test_write(struct esphome_ota_inflate *inflate, const uint8_t *data, size_t len)
+{
+	struct esphome_ota_inflate_tests_fixture *fixture =
+		CONTAINER_OF(inflate, struct esphome_ota_inflate_tests_fixture, inflate);
+
+	if (len > sizeof(fixture->out) - fixture->out_len) {
+		return -ENOSPC;
+	}
+
+	memcpy(fixture->out + fixture->out_len, data, len);
+	fixture->out_len += len;
+	fixture->write_calls++;
+
+	return 0;
+}
+
+static int test_inflate(struct esphome_ota_inflate_tests_fixture *fixture, const uint8_t *in,
+			size_t len)
+{
+	fixture->in = in;
+	fixture->in_len = len;
+
+	return esphome_ota_inflate(&fixture->inflate);
+}
+
+/* "block <n> of the image" lines, as compressed into dynamic_stream */
+static void dynamic_image(uint8_t *image)
+{
+	char line[32];
+	size_t pos = 0;
+	size_t len;
+
+	for (int i = 0; pos < DYNAMIC_SIZE; i++) {
+		len = snprintf(line, sizeof(line), "block %d of the image\n", i * 7 % 100);
+		len = MIN(len, DYNAMIC_SIZE - pos);
+		memcpy(image + pos, line, len);
+		pos += len;
+	}
+}
+
+static void *ota_inflate_setup(void)
+{
+	static struct esphome_ota_inflate_tests_fixture fixture;
+
+	return &fixture;
+}
+
+static void ota_inflate_before(void *f)
+{
+	struct esphome_ota_inflate_tests_fixture *fixture = f;
+
+	memset(fixture, 0, sizeof(*fixture));
+	fixture->inflate.read_byte = test_read_byte;
+	fixture->inflate.write = test_write;
+}
+
+ZTEST_SUITE(esphome_ota_inflate_tests, NULL, ota_inflate_setup, ota_inflate_before, NULL, NULL);
+
+ZTEST_F(esphome_ota_inflate_tests, test_esphome_ota_inflate_stored)
+{
+	static uint8_t stream[5 + STORED_SIZE] = {
+		0x01, STORED_SIZE & 0xff, STORED_SIZE >> 8,
+		~STORED_SIZE & 0xff, (~STORED_SIZE >> 8) & 0xff,
+	};
+	int ret;
+
+	for (int i = 0; i < STORED_SIZE; i++) {
+		stream[5 + i] = i * 13;
+	}
+
+	ret = test_inflate(fixture, stream, sizeof(stream));
+	zassert_equal(ret, 0);
+	zassert_equal(fixture->inflate.total, STORED_SIZE);
+	zassert_equal(fixture->out_len, STORED_SIZE);
+	zassert_mem_equal(fixture->out, stream + 5, STORED_SIZE);
+	/* Larger than the window, which is written when full and at the end */
+	zassert_equal(fixture->write_calls, 2);
+}
+
+ZTEST_F(esphome_ota_inflate_tests, test_esphome_ota_inflate_fixed)
+{
+	static const char image[] = "ESPHome OTA, ESPHome OTA, ESPHome OTA";
+	int ret;
+
+	ret = test_inflate(fixture, fixed_stream, sizeof(fixed_stream));
+	zassert_equal(ret, 0);
+	zassert_equal(fixture->out_len, strlen(image));
+	zassert_mem_equal(fixture->out, image, strlen(image));
+	zassert_equal(fixture->in_pos, sizeof(fixed_stream));
+}
+
+ZTEST_F(esphome_ota_inflate_tests, test_esphome_ota_inflate_dynamic)
+{
+	static uint8_t image[DYNAMIC_SIZE];
+	int ret;
+
+	dynamic_image(image);
+
+	ret = test_inflate(fixture, dynamic_stream, sizeof(dynamic_stream));
+	zassert_equal(ret, 0);
+	zassert_equal(fixture->out_len, DYNAMIC_SIZE);
+	zassert_mem_equal(fixture->out, image, DYNAMIC_SIZE);
+	zassert_equal(fixture->in_pos, sizeof(dynamic_stream));
+}
+
+ZTEST_F(esphome_ota_inflate_tests, test_esphome_ota_inflate_invalid_block_type)
+{
+	static const uint8_t stream[] = {0x07};
+	int ret;
+
+	ret = test_inflate(fixture, stream, sizeof(stream));
+	zassert_equal(ret, -EBADMSG);
+	zassert_equal(fixture->out_len, 0);
+}
+
+ZTEST_F(esphome_ota_inflate_tests, test_esphome_ota_inflate_invalid_stored_length)
+{
+	static const uint8_t stream[] = {0x01, 0x04, 0x00, 0x00, 0x00, 'O', 'T', 'A', '!'};
+	int ret;
+
+	ret = test_inflate(fixture, stream, sizeof(stream));
+	zassert_equal(ret, -EBADMSG);
+	zassert_equal(fixture->out_len, 0);
+}
+
+ZTEST_F(esphome_ota_inflate_tests, test_esphome_ota_inflate_reference_out_of_range)
+{
+	int ret;
+
+	ret = test_inflate(fixture, far_stream, sizeof(far_stream));
+	zassert_equal(ret, -EBADMSG);
+	zassert_equal(fixture->out_len, 0);
+}
+
+ZTEST_F(esphome_ota_inflate_tests, test_esphome_ota_inflate_truncated)
+{
+	int ret;
+
+	ret = test_inflate(fixture, dynamic_stream, sizeof(dynamic_stream) / 2);
+	zassert_equal(ret, -ENODATA);
+	zassert_true(fixture->out_len < DYNAMIC_SIZE);
+}
+
+ZTEST_F(esphome_ota_inflate_tests, test_esphome_ota_inflate_write_error)
+{
+	static uint8_t stream[5 + STORED_SIZE] = {
+		0x01, STORED_SIZE & 0xff, STORED_SIZE >> 8,
+		~STORED_SIZE & 0xff, (~STORED_SIZE >> 8) & 0xff,
+	};
+	int ret;
+
+	/* No room left when the full window is written */
+	fixture->out_len = sizeof(fixture->out) - 1;
+
+	ret = test_inflate(fixture, stream, sizeof(stream));
+	zassert_equal(ret, -ENOSPC);
+}
@@ -15,6 +15,8 @@
 struct esphome_switch_gpio_tests_fixture {
 	const struct device *dev;
 	const struct gpio_dt_spec gpio;
+	const struct device *dev_2;
+	const struct gpio_dt_spec gpio_2;
 };
 
 static void *switch_gpio_setup(void)
@@ -22,6 +24,8 @@ static void *switch_gpio_setup(void)
 	static struct esphome_switch_gpio_tests_fixture fixture = {
 		.dev = DEVICE_DT_GET(DT_PATH(gpio_switch)),
 		.gpio = GPIO_DT_SPEC_GET(DT_PATH(gpio_switch), gpios),
+		.dev_2 = DEVICE_DT_GET(DT_PATH(gpio_switch_2)),
+		.gpio_2 = GPIO_DT_SPEC_GET(DT_PATH(gpio_switch_2), gpios),
 	};
 	return &fixture;
 }
@@ -65,3 +69,47 @@ ZTEST_F(esphome_switch_gpio_tests, test_esphome_switch_gpio_get_state)
 	zassert_equal(ret, 0);
 	zassert_equal(state, 0);
 }
+
+ZTEST_F(esphome_switch_gpio_tests, test_esphome_switch_gpio_batch)
+{
+	struct esphome_switch_batch batch;
+	int state;
+	int ret;
+
+	esphome_switch_batch_init(&batch);
+	ret = esphome_switch_batch_add(&batch, fixture->dev, 1);
+	zassert_equal(ret, 0);
+	ret = esphome_switch_batch_add(&batch, fixture->dev_2, 1);
+	zassert_equal(ret, 0);
+
+	/* Nothing changes until the batch is applied */
+	zassert_equal(gpio_emul_output_get(fixture->gpio_2.port, 1), 1);
+
+	/* Both switches are on the same port, written at once */
+	zassert_equal(batch.port_count, 1);
+	ret = esphome_switch_batch_apply(&batch);
+	zassert_equal(ret, 0);
+
+	zassert_equal(gpio_emul_output_get(fixture->gpio.port, 0), 1);
+	/* Active low */
+	zassert_equal(gpio_emul_output_get(fixture->gpio_2.port, 1), 0);
+
+	ret = esphome_switch_get_state(fixture->dev_2, &state);
+	zassert_equal(ret, 0);
+	zassert_equal(state, 1);
+
+	/* The last state of a switch staged twice wins */
+	esphome_switch_batch_init(&batch);
+	ret = esphome_switch_batch_add(&batch, fixture->dev_2, 1);
+	zassert_equal(ret, 0);
+	ret = esphome_switch_batch_add(&batch, fixture->dev_2, 0);
+	zassert_equal(ret, 0);
+	zassert_equal(batch.switch_count, 1);
+	ret = esphome_switch_batch_apply(&batch);
+	zassert_equal(ret, 0);
+
+	zassert_equal(gpio_emul_output_get(fixture->gpio_2.port, 1), 1);
+	ret = esphome_switch_get_state(fixture->dev_2, &state);
+	zassert_equal(ret, 0);
+	zassert_equal(state, 0);
+}